@@ -0,0 +1,20 @@
+# Compare perft node counts of the reference positions in tests/perft to the expected ones.
+# Each line of tests/perft/expected_counts holds a position file, a depth and a node count.
+fail=0
+while read -r file depth expected
+do
+	found=$(./chessprog -perft "$depth" "tests/perft/$file" | sed -n 's/^Nodes: //p')
+	if [ "$found" = "$expected" ]
+	then
+		echo "OK   $file depth $depth: $found"
+	else
+		echo "FAIL $file depth $depth: expected $expected, found $found"
+		fail=1
+	fi
+done < tests/perft/expected_counts
+echo
+if [ $fail = 0 ]
+then
+	echo 'Results are as expected'
+fi
+exit $fail
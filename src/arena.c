@@ -0,0 +1,60 @@
+#include <stdlib.h>
+#include "arena.h"
+
+#define ALIGN_UP(size) (((size) + ARENA_ALIGNMENT - 1) & ~(size_t)(ARENA_ALIGNMENT - 1))
+/* Bytes skipped at the start of the data of a block, so that allocations are aligned */
+#define BLOCK_PADDING (ALIGN_UP(sizeof(ArenaBlock)) - sizeof(ArenaBlock))
+
+/*
+ * Allocate a block with at least the given number of bytes and push it onto the arena.
+ */
+static ArenaBlock *add_block(Arena *arena, size_t size){
+	if(size < arena->block_size) size = arena->block_size;
+	ArenaBlock *block = malloc(sizeof(ArenaBlock) + BLOCK_PADDING + size);
+	if(!block) return NULL;
+	block->next = arena->blocks;
+	block->size = BLOCK_PADDING + size;
+	block->used = BLOCK_PADDING;
+	arena->blocks = block;
+	arena->total_size += size;
+	return block;
+}
+
+void arena_init(Arena *arena, size_t block_size){
+	arena->blocks = NULL;
+	arena->total_size = 0;
+	arena->block_size = block_size ? block_size : DEFAULT_ARENA_BLOCK_SIZE;
+}
+
+void *arena_alloc(Arena *arena, size_t size){
+	size = ALIGN_UP(size);
+	ArenaBlock *block = arena->blocks;
+	if(!block || block->size - block->used < size){
+		if(!(block = add_block(arena, size))) return NULL;
+	}
+	void *ptr = block->data + block->used;
+	block->used += size;
+	return ptr;
+}
+
+void arena_reset(Arena *arena){
+	ArenaBlock *block = arena->blocks;
+	if(!block) return;
+	if(!block->next){
+		block->used = BLOCK_PADDING;
+		return;
+	}
+	/* Replace all blocks by one holding all of them */
+	size_t total_size = arena->total_size;
+	arena_destroy(arena);
+	add_block(arena, total_size);
+}
+
+void arena_destroy(Arena *arena){
+	while(arena->blocks){
+		ArenaBlock *next = arena->blocks->next;
+		free(arena->blocks);
+		arena->blocks = next;
+	}
+	arena->total_size = 0;
+}
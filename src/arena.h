@@ -0,0 +1,63 @@
+#ifndef ARENA_H
+#define ARENA_H
+/*
+ * Arena allocator module for memory that lives as long as a single task, such as a search.
+ * Allocations are carved out of large blocks by bumping an offset and are never freed one by
+ * one. Resetting or destroying the arena releases all of them at once.
+ * An arena must only be used by one thread at a time.
+ *
+ * Summary of interface:
+ * arena_init    	 initialize an empty arena
+ * arena_alloc   	 allocate memory from an arena
+ * arena_reset   	 release all allocations of an arena, keeping its memory for reuse
+ * arena_destroy 	 free all memory of an arena
+ */
+#include <stddef.h>
+
+#define DEFAULT_ARENA_BLOCK_SIZE (256 * 1024)
+#define ARENA_ALIGNMENT 16
+
+/* Single block of memory allocations are carved out of */
+typedef struct ArenaBlock {
+	struct ArenaBlock *next; /* block allocated before this one, NULL if none */
+	size_t size; /* bytes available in data */
+	size_t used; /* bytes of data handed out so far */
+	unsigned char data[];
+} ArenaBlock;
+
+/* Struct holding the blocks of a single arena */
+typedef struct Arena {
+	ArenaBlock *blocks; /* most recently allocated block, NULL if none */
+	size_t block_size; /* minimal size of new blocks */
+	size_t total_size; /* bytes available in all blocks together */
+} Arena;
+
+/*
+ * Initialize an empty arena. No memory is allocated until the first allocation.
+ * @param arena      	 arena to initialize
+ * @param block_size 	 minimal size of the blocks of the arena, 0 for the default size
+ */
+void arena_init(Arena *arena, size_t block_size);
+
+/*
+ * Allocate memory from an arena, aligned for any type the engine uses.
+ * @param arena 	 arena instance
+ * @param size  	 number of bytes to allocate
+ * @return      	 pointer to uninitialized memory on success, NULL if a block can't be allocated
+ */
+void *arena_alloc(Arena *arena, size_t size);
+
+/*
+ * Release all allocations of an arena. If the arena grew into several blocks, they are replaced
+ * by a single block holding all of them, so the same allocations again don't allocate memory.
+ * @param arena 	 arena instance
+ */
+void arena_reset(Arena *arena);
+
+/*
+ * Free all memory of an arena, leaving it empty.
+ * @param arena 	 arena instance
+ */
+void arena_destroy(Arena *arena);
+
+#endif /* ifndef ARENA_H */
@@ -0,0 +1,89 @@
+#include "bench.h"
+#include "minimax.h"
+#include "transposition_table.h"
+#include "print_utils.h"
+#include "timer.h"
+
+#define FNV_OFFSET_BASIS 0xcbf29ce484222325ULL
+#define FNV_PRIME 0x100000001b3ULL
+
+/*
+ * Mix a value into a signature, FNV-1a style.
+ */
+static unsigned long long mix_signature(unsigned long long signature, long long value){
+	for(int i = 0; i < 8; i++){
+		signature ^= (value >> (i * 8)) & 0xff;
+		signature *= FNV_PRIME;
+	}
+	return signature;
+}
+
+EngineMessage run_bench(char **files, int count, unsigned int depth){
+	unsigned long long signature = FNV_OFFSET_BASIS;
+	long total_nodes = 0;
+	double total_seconds = 0;
+
+	/* All positions share one table, allocated up front so that only searches are timed */
+	TranspositionTable *table = create_transposition_table(get_hash_size());
+	if(!table) return MALLOC_FAILURE;
+
+	unsigned int seed = get_shuffle_seed();
+	for(int i = 0; i < count; i++){
+		/* Order pieces the same way whatever positions were loaded before */
+		set_shuffle_seed(seed);
+		FILE *in = fopen(files[i], "r");
+		Game *game = in ? load_game(in) : NULL;
+		if(in) fclose(in);
+		if(!game){
+			destroy_transposition_table(table);
+			return LOAD_ERROR;
+		}
+
+		/* Search each position from an empty table, as a new game would */
+		clear_transposition_table(table);
+		game->tt = table;
+		SearchOptions options;
+		init_search_options(&options, depth);
+		GameMove move = {-1, -1, -1, -1};
+		SearchStats stats;
+		long long start_us = current_time_us();
+		EngineMessage msg = minimax_suggest_move(game, &options, &move, &stats);
+		double seconds = (current_time_us() - start_us) / 1e6;
+		game->tt = NULL;
+		destroy_game(game);
+		if(msg != SUCCESS){
+			destroy_transposition_table(table);
+			return msg;
+		}
+
+		long nodes = stats.nodes + stats.qnodes;
+		total_nodes += nodes;
+		total_seconds += seconds;
+		signature = mix_signature(signature, nodes);
+		signature = mix_signature(signature, move.src_x);
+		signature = mix_signature(signature, move.src_y);
+		signature = mix_signature(signature, move.dst_x);
+		signature = mix_signature(signature, move.dst_y);
+
+		printf("%s: ", files[i]);
+		if(move.src_x < 0){
+			printf("no move");
+		} else {
+			print_position_repr(move.src_x, move.src_y);
+			printf(" -> ");
+			print_position_repr(move.dst_x, move.dst_y);
+		}
+		printf(", nodes %ld, time %.0f ms, NPS %.0f\n", nodes, seconds * 1000,
+				seconds > 0 ? nodes / seconds : 0.0);
+	}
+
+	destroy_transposition_table(table);
+
+	printf("\nPositions: %d\n", count);
+	printf("Depth: %u\n", depth);
+	printf("Nodes: %ld\n", total_nodes);
+	printf("Time: %.0f ms\n", total_seconds * 1000);
+	printf("NPS: %.0f\n", total_seconds > 0 ? total_nodes / total_seconds : 0.0);
+	printf("Signature: %016llx\n", signature);
+	return SUCCESS;
+}
@@ -0,0 +1,27 @@
+#ifndef BENCH_H
+#define BENCH_H
+/*
+ * Bench module running the search over a set of saved positions, used to track search speed
+ * and to detect changes to the moves it suggests.
+ *
+ * Summary of interface:
+ * run_bench 	 search saved positions to a fixed depth and print nodes, time and moves
+ */
+#include "game_engine.h"
+
+/*
+ * Load each of the given saved games and search it to the given depth with the default search
+ * options. The pieces of each game are shuffled from the current shuffle seed, so the result of
+ * a position doesn't depend on the other positions. Print the suggested move, node count, time
+ * taken and nodes per second of each position, followed by the totals and a signature of all
+ * moves and node counts. The signature changes whenever the search visits a different tree, so
+ * equal signatures mean equal searches.
+ * @param files 	 paths of saved games
+ * @param count 	 number of saved games
+ * @param depth 	 depth to search each position to
+ * @return      	 SUCCESS on success, LOAD_ERROR if a file could not be loaded,
+ *              	 MALLOC_FAILURE if an allocation failed
+ */
+EngineMessage run_bench(char **files, int count, unsigned int depth);
+
+#endif /* ifndef BENCH_H */
@@ -0,0 +1,281 @@
+#include <stdlib.h>
+#include "bitboard.h"
+
+/* PEXT indexing is compiled in on x86-64 and used if the processor supports BMI2 */
+#if defined(__GNUC__) && defined(__x86_64__) && !defined(NO_PEXT)
+#define HAVE_PEXT 1
+#include <immintrin.h>
+#endif
+
+#define ROOK_TABLE_SIZE 102400 /* sum of 2^(relevant squares) over all squares */
+#define BISHOP_TABLE_SIZE 5248
+
+/* Sliding attack lookup of a single square */
+typedef struct {
+	Bitboard mask; /* squares whose occupancy affects the attacks, board edges excluded */
+	Bitboard magic; /* multiplier hashing occupancies of mask into the table */
+	int shift; /* 64 minus the number of squares in mask */
+	Bitboard *attacks; /* attack sets of the square, indexed by slider_index */
+} SliderEntry;
+
+/* Column and row steps of each ray direction, indexed by Direction */
+static const int direction_x[DIRECTION_COUNT] = {0, 0, 1, -1, 1, -1, 1, -1};
+static const int direction_y[DIRECTION_COUNT] = {1, -1, 0, 0, 1, 1, -1, -1};
+
+/* Attack tables indexed by square, filled once by init_attack_tables */
+static Bitboard pawn_table[2][SQUARE_COUNT]; /* indexed by whether the pawn moves up the board */
+static Bitboard knight_table[SQUARE_COUNT];
+static Bitboard king_table[SQUARE_COUNT];
+static Bitboard ray_table[DIRECTION_COUNT][SQUARE_COUNT]; /* rays on an empty board */
+static Bitboard between_table[SQUARE_COUNT][SQUARE_COUNT];
+static Bitboard rook_table[ROOK_TABLE_SIZE];
+static Bitboard bishop_table[BISHOP_TABLE_SIZE];
+static SliderEntry rook_entries[SQUARE_COUNT];
+static SliderEntry bishop_entries[SQUARE_COUNT];
+static const Direction rook_directions[] = {NORTH, SOUTH, EAST, WEST};
+static const Direction bishop_directions[] = {NORTH_EAST, NORTH_WEST, SOUTH_EAST, SOUTH_WEST};
+#ifdef HAVE_PEXT
+static int use_pext = 0; /* whether slider tables are indexed by PEXT instead of magics */
+#endif
+static int initialized = 0;
+
+/* Magic multipliers of each square, found offline by trying sparse random numbers until all
+ * occupancies of the mask of the square map to indices holding the right attacks */
+static const Bitboard rook_magics[SQUARE_COUNT] = {
+	0x0A80008010400021ULL, 0x6240044020001000ULL, 0x0480100280200008ULL, 0x2500100008450020ULL,
+	0x02000802004420D0ULL, 0x0580040080010200ULL, 0x0180060041000280ULL, 0x4100004C23000882ULL,
+	0x000880008C614010ULL, 0x01A0400020005001ULL, 0x0301802001805000ULL, 0x0102000812402200ULL,
+	0x2201000500080010ULL, 0x4029000400230008ULL, 0x0004000890010402ULL, 0x0005000040910002ULL,
+	0x008000C000200050ULL, 0x0000820020410200ULL, 0x4011010010200840ULL, 0x0022090010002300ULL,
+	0x0028004004020040ULL, 0x3202008004008002ULL, 0x0900040048015002ULL, 0x004402000B440481ULL,
+	0x0280014340002000ULL, 0x8110004040002010ULL, 0x0000410100200012ULL, 0x0000080080801000ULL,
+	0x0060040080080080ULL, 0x4086000200040810ULL, 0x86B0509400052608ULL, 0x0005240200004081ULL,
+	0x0500400584800220ULL, 0x0030002000C00150ULL, 0x4840200080801002ULL, 0x0004210009001000ULL,
+	0x00A8800801800400ULL, 0x2182040080800200ULL, 0x00420004D2000118ULL, 0x6411090042000884ULL,
+	0xD080400020808001ULL, 0x4080810040010020ULL, 0x0408120080420020ULL, 0x888512004122000AULL,
+	0x8807001008010004ULL, 0x2015020004008080ULL, 0x002A011008040002ULL, 0x210090A100C2000CULL,
+	0x0014804108221200ULL, 0x1020100040002040ULL, 0x0020012D80100080ULL, 0x5024080080100480ULL,
+	0x2000080004110100ULL, 0x0928702420406801ULL, 0x8000010810824400ULL, 0x1086009420410200ULL,
+	0x4040410080022053ULL, 0x0A00108021004001ULL, 0x0490200104401009ULL, 0x0086002008400412ULL,
+	0x040200080411E002ULL, 0x3012000108841002ULL, 0x4600080090010204ULL, 0x0008042241059402ULL
+};
+static const Bitboard bishop_magics[SQUARE_COUNT] = {
+	0x00200404082260E3ULL, 0x0845212202020000ULL, 0x411854C102000420ULL, 0x0111040080481002ULL,
+	0x93020210A6040040ULL, 0x4322082405700600ULL, 0x0D24010803100880ULL, 0x8D028400484C0400ULL,
+	0x0004920490040040ULL, 0x8000100108108882ULL, 0x0046040404A600C0ULL, 0x4104080A00200A02ULL,
+	0x0444020210A04808ULL, 0x04040208022A0002ULL, 0x0200020092A01040ULL, 0x800243441C240221ULL,
+	0x1009006052108209ULL, 0x2620200401842900ULL, 0x5090042045082020ULL, 0xA808205404021011ULL,
+	0x3004001211040044ULL, 0x0080200200842000ULL, 0x8304241201010824ULL, 0x0001100045080101ULL,
+	0x0820200304840440ULL, 0x0102100602041800ULL, 0x0038040402002A04ULL, 0x011C090018010500ULL,
+	0x0400840004802002ULL, 0x2009120003008080ULL, 0x0062009400480803ULL, 0x0801020000420090ULL,
+	0x000248040A202140ULL, 0x0008040210040820ULL, 0xA080180202040C00ULL, 0x0002004040040100ULL,
+	0x88028C0240140100ULL, 0x300A100042060811ULL, 0x1010010A04010081ULL, 0x4001085608010100ULL,
+	0x2401240241082028ULL, 0x1044008410080500ULL, 0x286081C1404A0808ULL, 0x9000002011001800ULL,
+	0x0488010214000200ULL, 0x0120014202880200ULL, 0x0010100101220840ULL, 0x5208110900200200ULL,
+	0x204880B038201000ULL, 0x1080289808081021ULL, 0x088005048824200AULL, 0x0020020084040000ULL,
+	0x6801024030818582ULL, 0x0010454910010243ULL, 0x0442040802244100ULL, 0x8010018204004025ULL,
+	0x1012010048040400ULL, 0x2080005C01915100ULL, 0x0E00410022011002ULL, 0x910254400046080BULL,
+	0x1400000004050400ULL, 0x0008002085410200ULL, 0x04C2400401040121ULL, 0x0040480881144500ULL
+};
+
+/*
+ * Get bitboard of a single position, or an empty set if it is off the board.
+ */
+static Bitboard position_bb(int pos_x, int pos_y){
+	if(pos_x < 0 || pos_x >= BB_SIZE || pos_y < 0 || pos_y >= BB_SIZE) return 0;
+	return SQUARE_BB(SQUARE(pos_x, pos_y));
+}
+
+int bb_count(Bitboard bb){
+	return __builtin_popcountll(bb);
+}
+
+int bb_first(Bitboard bb){
+	return __builtin_ctzll(bb);
+}
+
+int bb_last(Bitboard bb){
+	return SQUARE_COUNT - 1 - __builtin_clzll(bb);
+}
+
+int bb_pop_first(Bitboard *bb){
+	int sq = bb_first(*bb);
+	*bb &= *bb - 1;
+	return sq;
+}
+
+int bb_pop_last(Bitboard *bb){
+	int sq = bb_last(*bb);
+	*bb ^= SQUARE_BB(sq);
+	return sq;
+}
+
+/*
+ * Check whether squares along a ray of the given direction increase.
+ */
+static int is_upward(Direction dir){
+	return direction_y[dir] > 0 || (direction_y[dir] == 0 && direction_x[dir] > 0);
+}
+
+/*
+ * Get squares along a single ray on an empty board, computed square by square.
+ */
+static Bitboard compute_ray(int sq, Direction dir){
+	Bitboard ray = 0;
+	int x = SQUARE_X(sq) + direction_x[dir];
+	int y = SQUARE_Y(sq) + direction_y[dir];
+	Bitboard target;
+	/* Advance until board edge has been reached */
+	while((target = position_bb(x, y))){
+		ray |= target;
+		x += direction_x[dir];
+		y += direction_y[dir];
+	}
+	return ray;
+}
+
+#ifdef HAVE_PEXT
+/*
+ * Gather the bits of bb selected by mask into the low bits of the result.
+ */
+__attribute__((target("bmi2"))) static Bitboard pext(Bitboard bb, Bitboard mask){
+	return _pext_u64(bb, mask);
+}
+#endif
+
+/*
+ * Get index of the attacks of the given occupancy in the table of a slider entry.
+ */
+static inline int slider_index(const SliderEntry *entry, Bitboard occupied){
+#ifdef HAVE_PEXT
+	if(use_pext) return (int)pext(occupied, entry->mask);
+#endif
+	return (int)(((occupied & entry->mask) * entry->magic) >> entry->shift);
+}
+
+/*
+ * Get squares attacked along the given rays by stepping through the ray table.
+ */
+static Bitboard compute_slider_attacks(int sq, const Direction *dirs, Bitboard occupied){
+	Bitboard attacks = 0;
+	for(int i = 0; i < 4; i++){
+		attacks |= ray_attacks(sq, dirs[i], occupied);
+	}
+	return attacks;
+}
+
+/*
+ * Fill the slider entries of all squares and their attack tables.
+ */
+static void init_slider_entries(SliderEntry *entries, Bitboard *table, const Bitboard *magics,
+		const Direction *dirs){
+	Bitboard *attacks = table;
+	for(int sq = 0; sq < SQUARE_COUNT; sq++){
+		SliderEntry *entry = &entries[sq];
+		entry->mask = 0;
+		for(int i = 0; i < 4; i++){
+			/* The last square of a ray is attacked whether or not it is occupied */
+			Bitboard ray = ray_table[dirs[i]][sq];
+			if(ray) ray ^= SQUARE_BB(is_upward(dirs[i]) ? bb_last(ray) : bb_first(ray));
+			entry->mask |= ray;
+		}
+		entry->magic = magics[sq];
+		entry->shift = SQUARE_COUNT - bb_count(entry->mask);
+		entry->attacks = attacks;
+		attacks += 1 << bb_count(entry->mask);
+		/* Enumerate all subsets of the mask */
+		Bitboard occupied = 0;
+		do {
+			entry->attacks[slider_index(entry, occupied)] =
+				compute_slider_attacks(sq, dirs, occupied);
+			occupied = (occupied - entry->mask) & entry->mask;
+		} while(occupied);
+	}
+}
+
+void init_attack_tables(){
+	if(initialized) return;
+	for(int sq = 0; sq < SQUARE_COUNT; sq++){
+		int x = SQUARE_X(sq), y = SQUARE_Y(sq);
+		pawn_table[0][sq] = position_bb(x-1, y-1) | position_bb(x+1, y-1);
+		pawn_table[1][sq] = position_bb(x-1, y+1) | position_bb(x+1, y+1);
+		knight_table[sq] = 0;
+		for(int i = -2; i <= 2; i++){
+			if(i == 0) continue;
+			int j = (abs(i) == 1) ? 2 : 1;
+			knight_table[sq] |= position_bb(x-j, y+i) | position_bb(x+j, y+i);
+		}
+		king_table[sq] = 0;
+		for(int i = -1; i <= 1; i++){
+			for(int j = -1; j <= 1; j++){
+				if(i == 0 && j == 0) continue;
+				king_table[sq] |= position_bb(x+i, y+j);
+			}
+		}
+		for(int dir = 0; dir < DIRECTION_COUNT; dir++){
+			ray_table[dir][sq] = compute_ray(sq, dir);
+		}
+	}
+	/* Squares between two aligned squares are the ray from one of them up to the other */
+	for(int a = 0; a < SQUARE_COUNT; a++){
+		for(int b = 0; b < SQUARE_COUNT; b++){
+			between_table[a][b] = 0;
+			for(int dir = 0; dir < DIRECTION_COUNT; dir++){
+				if(ray_table[dir][a] & SQUARE_BB(b)){
+					between_table[a][b] = ray_table[dir][a] & ~ray_table[dir][b] & ~SQUARE_BB(b);
+					break;
+				}
+			}
+		}
+	}
+#ifdef HAVE_PEXT
+	use_pext = __builtin_cpu_supports("bmi2");
+#endif
+	init_slider_entries(rook_entries, rook_table, rook_magics, rook_directions);
+	init_slider_entries(bishop_entries, bishop_table, bishop_magics, bishop_directions);
+	initialized = 1;
+}
+
+Bitboard pawn_attacks(int sq, int direction){
+	return pawn_table[direction > 0][sq];
+}
+
+Bitboard knight_attacks(int sq){
+	return knight_table[sq];
+}
+
+Bitboard king_attacks(int sq){
+	return king_table[sq];
+}
+
+Bitboard ray_attacks(int sq, Direction dir, Bitboard occupied){
+	Bitboard attacks = ray_table[dir][sq];
+	Bitboard blockers = attacks & occupied;
+	if(!blockers) return attacks;
+	/* Cut the ray behind the nearest blocker, which is the lowest square of rays going up
+	 * the board and the highest of rays going down */
+	int blocker = is_upward(dir) ? bb_first(blockers) : bb_last(blockers);
+	return attacks ^ ray_table[dir][blocker];
+}
+
+Bitboard rook_attacks(int sq, Bitboard occupied){
+	const SliderEntry *entry = &rook_entries[sq];
+	return entry->attacks[slider_index(entry, occupied)];
+}
+
+Bitboard bishop_attacks(int sq, Bitboard occupied){
+	const SliderEntry *entry = &bishop_entries[sq];
+	return entry->attacks[slider_index(entry, occupied)];
+}
+
+Bitboard queen_attacks(int sq, Bitboard occupied){
+	return rook_attacks(sq, occupied) | bishop_attacks(sq, occupied);
+}
+
+Bitboard ray_mask(int sq, Direction dir){
+	return ray_table[dir][sq];
+}
+
+Bitboard squares_between(int a, int b){
+	return between_table[a][b];
+}
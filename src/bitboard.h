@@ -0,0 +1,171 @@
+#ifndef BITBOARD_H
+#define BITBOARD_H
+/*
+ * Bitboard module containing 64-bit board sets and attack generation.
+ * Square i of a bitboard corresponds to board position (i % 8, i / 8), i.e. row major
+ * order starting at the bottom left corner of the board.
+ * Attacks are looked up in tables computed once by init_attack_tables, which must be called
+ * before any attack function. Rook and bishop attacks are indexed by their relevant occupancy,
+ * gathered by PEXT on processors supporting BMI2 and hashed by magic multiplication otherwise
+ * (or always, when built with NO_PEXT defined).
+ *
+ * Summary of interface:
+ * init_attack_tables 	 compute attack tables of all squares
+ * bb_count        	 count squares in a set
+ * bb_first        	 get lowest square in a set
+ * bb_last         	 get highest square in a set
+ * bb_pop_first    	 remove and return lowest square in a set
+ * bb_pop_last     	 remove and return highest square in a set
+ * pawn_attacks    	 squares attacked by a pawn
+ * knight_attacks  	 squares attacked by a knight
+ * king_attacks    	 squares attacked by a king
+ * ray_attacks     	 squares attacked along a single ray, up to the first blocker
+ * rook_attacks    	 squares attacked by a rook
+ * bishop_attacks  	 squares attacked by a bishop
+ * queen_attacks   	 squares attacked by a queen
+ * ray_mask        	 squares along a single ray on an empty board
+ * squares_between 	 squares strictly between two aligned squares
+ */
+#include <stdint.h>
+
+#define SQUARE_COUNT 64
+#define BB_SIZE 8
+
+typedef uint64_t Bitboard;
+
+typedef enum {
+	NORTH,
+	SOUTH,
+	EAST,
+	WEST,
+	NORTH_EAST,
+	NORTH_WEST,
+	SOUTH_EAST,
+	SOUTH_WEST
+} Direction;
+
+#define DIRECTION_COUNT 8
+
+#define SQUARE(x, y) ((y) * BB_SIZE + (x))
+#define SQUARE_X(sq) ((sq) % BB_SIZE)
+#define SQUARE_Y(sq) ((sq) / BB_SIZE)
+#define SQUARE_BB(sq) ((Bitboard)1 << (sq))
+#define FILE_BB(x) ((Bitboard)0x0101010101010101ULL << (x))
+#define RANK_BB(y) ((Bitboard)0xFFULL << ((y) * BB_SIZE))
+
+/*
+ * Compute the attack tables of all squares, if they weren't computed yet.
+ */
+void init_attack_tables();
+
+/*
+ * Count the number of squares in the given set.
+ * @param bb 	 set of squares
+ * @return   	 number of squares in set
+ */
+int bb_count(Bitboard bb);
+
+/*
+ * Get lowest square in the given set.
+ * @precond  	 bb != 0
+ * @param bb 	 set of squares
+ * @return   	 index of lowest square
+ */
+int bb_first(Bitboard bb);
+
+/*
+ * Get highest square in the given set.
+ * @precond  	 bb != 0
+ * @param bb 	 set of squares
+ * @return   	 index of highest square
+ */
+int bb_last(Bitboard bb);
+
+/*
+ * Remove lowest square from the given set.
+ * @precond  	 *bb != 0
+ * @param bb 	 pointer to set of squares
+ * @return   	 index of removed square
+ */
+int bb_pop_first(Bitboard *bb);
+
+/*
+ * Remove highest square from the given set.
+ * @precond  	 *bb != 0
+ * @param bb 	 pointer to set of squares
+ * @return   	 index of removed square
+ */
+int bb_pop_last(Bitboard *bb);
+
+/*
+ * Get squares attacked by a pawn.
+ * @param sq        	 square of the pawn
+ * @param direction 	 row direction the pawn moves in (1 for white, -1 for black)
+ * @return          	 set of attacked squares
+ */
+Bitboard pawn_attacks(int sq, int direction);
+
+/*
+ * Get squares attacked by a knight.
+ * @param sq 	 square of the knight
+ * @return   	 set of attacked squares
+ */
+Bitboard knight_attacks(int sq);
+
+/*
+ * Get squares attacked by a king.
+ * @param sq 	 square of the king
+ * @return   	 set of attacked squares
+ */
+Bitboard king_attacks(int sq);
+
+/*
+ * Get squares attacked along a single ray, including the first occupied square.
+ * @param sq        	 source square
+ * @param dir       	 direction of the ray
+ * @param occupied  	 set of occupied squares
+ * @return          	 set of attacked squares
+ */
+Bitboard ray_attacks(int sq, Direction dir, Bitboard occupied);
+
+/*
+ * Get squares attacked by a rook.
+ * @param sq       	 square of the rook
+ * @param occupied 	 set of occupied squares
+ * @return         	 set of attacked squares
+ */
+Bitboard rook_attacks(int sq, Bitboard occupied);
+
+/*
+ * Get squares attacked by a bishop.
+ * @param sq       	 square of the bishop
+ * @param occupied 	 set of occupied squares
+ * @return         	 set of attacked squares
+ */
+Bitboard bishop_attacks(int sq, Bitboard occupied);
+
+/*
+ * Get squares attacked by a queen.
+ * @param sq       	 square of the queen
+ * @param occupied 	 set of occupied squares
+ * @return         	 set of attacked squares
+ */
+Bitboard queen_attacks(int sq, Bitboard occupied);
+
+/*
+ * Get squares along a single ray on an empty board, up to the board edge.
+ * @param sq  	 source square
+ * @param dir 	 direction of the ray
+ * @return    	 set of squares along the ray, not including sq
+ */
+Bitboard ray_mask(int sq, Direction dir);
+
+/*
+ * Get squares strictly between two squares on the same row, column or diagonal.
+ * @param a 	 first square
+ * @param b 	 second square
+ * @return  	 set of squares between a and b, empty if they are not aligned
+ */
+Bitboard squares_between(int a, int b);
+
+#endif /* ifndef BITBOARD_H */
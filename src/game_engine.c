@@ -1,6 +1,14 @@
 #include <stdlib.h>
 #include <ctype.h>
 #include "game_engine.h"
+#include "transposition_table.h"
+#include "arena.h"
+
+const int piece_values[PIECE_TYPE_COUNT] = {1, 3, 5, 3, 9, 100};
+
+static RngState shuffle_rng;
+static unsigned int shuffle_seed = DEFAULT_RNG_SEED;
+static int shuffle_rng_seeded = 0;
 
 /******************************* Interface functions *********************************/
 
@@ -9,25 +17,15 @@ Game *create_game(GameSettings *settings){
 	if(settings->difficulty < 1 || settings->difficulty > 4) return NULL;
 	Game *game = malloc(sizeof(Game));
 	if(!game) return NULL;
-
-	game->white_pieces = spArrayListCreate(sizeof(GamePiece), ARRAY_SIZE);
-	game->black_pieces = spArrayListCreate(sizeof(GamePiece), ARRAY_SIZE);
-	game->move_history = spArrayListCreate(sizeof(GameMove), HISTORY_SIZE);
-	game->removed_pieces = spArrayListCreate(sizeof(GamePiece), HISTORY_SIZE);
-	if(!game->white_pieces ||
-			!game->black_pieces ||
-			!game->move_history ||
-			!game->removed_pieces){
-		destroy_game(game);
-		return NULL;
-	}
+	game->tt = NULL;
+	game->arena = NULL;
+	init_zobrist_keys();
+	init_attack_tables();
 
 	/* Initialize board to be empty */
-	for(int i = 0; i < BOARD_SIZE; i++){
-		for(int j = 0; j < BOARD_SIZE; j++){
-			game->board[i][j] = NULL;
-		}
-	}
+	clear_board(game);
+	game->history_last = 0;
+	game->history_count = 0;
 	game->mode = settings->mode;
 	game->difficulty = settings->difficulty;
 	game->check = 0;
@@ -47,53 +45,25 @@ Game *copy_game(Game *game){
 
 	Game *copy = malloc(sizeof(Game));
 	if(!copy) return NULL;
-
-	copy->white_pieces = spArrayListCopy(game->white_pieces);
-	copy->black_pieces = spArrayListCopy(game->black_pieces);
-	copy->move_history = spArrayListCopy(game->move_history);
-	copy->removed_pieces = spArrayListCopy(game->removed_pieces);
-	if(!copy->white_pieces ||
-			!copy->black_pieces ||
-			!copy->move_history ||
-			!copy->removed_pieces){
-		destroy_game(copy);
-		return NULL;
-	}
-
-	/* Initialize board to be empty */
-	for(int i = 0; i < BOARD_SIZE; i++){
-		for(int j = 0; j < BOARD_SIZE; j++){
-			copy->board[i][j] = NULL;
-		}
-	}
-	/* Place copied pieces on new board */
-	for(int i = 0; i < spArrayListSize(copy->white_pieces); i++){
-		GamePiece *piece = spArrayListGetAt(copy->white_pieces, i);
-		copy->board[piece->pos_y][piece->pos_x] = piece;
-	}
-	for(int i = 0; i < spArrayListSize(copy->black_pieces); i++){
-		GamePiece *piece = spArrayListGetAt(copy->black_pieces, i);
-		copy->board[piece->pos_y][piece->pos_x] = piece;
-	}
-
-	for(int i = 0; i < PLAYER_COUNT; i++){
-		copy->player_color[i] = game->player_color[i];
-	}
-	copy->mode = game->mode;
-	copy->current_player = game->current_player;
-	copy->difficulty = game->difficulty;
-	copy->check = game->check;
+	*copy = *game;
+	copy->tt = NULL; /* search results are not shared with copies */
+	copy->arena = NULL;
 	return copy;
 }
 
+GamePiece *get_game_piece(Game *game, int pos_x, int pos_y){
+	int index = game->squares[pos_y][pos_x];
+	if(index == NO_PIECE) return NULL;
+	return &game->pieces[index / ARRAY_SIZE][index % ARRAY_SIZE];
+}
+
 void destroy_game(Game *game){
 	if(!game) return;
 
 	/* Free all allocated memory */
-	spArrayListDestroy(game->white_pieces);
-	spArrayListDestroy(game->black_pieces);
-	spArrayListDestroy(game->move_history);
-	spArrayListDestroy(game->removed_pieces);
+	destroy_transposition_table(game->tt);
+	if(game->arena) arena_destroy(game->arena);
+	free(game->arena);
 	free(game);
 }
 
@@ -112,25 +82,15 @@ Game *load_game(FILE *in){
 	/* Initialize game object */
 	Game *game = malloc(sizeof(Game));
 	if(!game) return NULL;
-
-	game->white_pieces = spArrayListCreate(sizeof(GamePiece), ARRAY_SIZE);
-	game->black_pieces = spArrayListCreate(sizeof(GamePiece), ARRAY_SIZE);
-	game->move_history = spArrayListCreate(sizeof(GameMove), HISTORY_SIZE);
-	game->removed_pieces = spArrayListCreate(sizeof(GamePiece), HISTORY_SIZE);
-	if(!game->white_pieces ||
-			!game->black_pieces ||
-			!game->move_history ||
-			!game->removed_pieces){
-		destroy_game(game);
-		return NULL;
-	}
+	game->tt = NULL;
+	game->arena = NULL;
+	init_zobrist_keys();
+	init_attack_tables();
 
 	/* Initialize board to be empty */
-	for(int i = 0; i < BOARD_SIZE; i++){
-		for(int j = 0; j < BOARD_SIZE; j++){
-			game->board[i][j] = NULL;
-		}
-	}
+	clear_board(game);
+	game->history_last = 0;
+	game->history_count = 0;
 	game->mode = 1;
 	game->difficulty = 2;
 	game->check = 0;
@@ -152,25 +112,17 @@ Game *load_game(FILE *in){
 		next_close(); /* consume closing tag */
 	}
 	free(buf);
+	/* Players might have been flipped while reading, so compute the key from scratch */
+	game->hash = compute_hash(game);
 	game->check = is_in_check_state(game);
-	spArrayListShuffle(game->white_pieces);
-	spArrayListShuffle(game->black_pieces);
+	shuffle_game_pieces(game, WHITE);
+	shuffle_game_pieces(game, BLACK);
 	return game;
 }
 
-GameMove *copy_move(GameMove *move){
-	GameMove *copy = (GameMove *)malloc(sizeof(GameMove));
-	if(!copy) return NULL;
-	copy->src_x = move->src_x;
-	copy->src_y = move->src_y;
-	copy->dst_x = move->dst_x;
-	copy->dst_y = move->dst_y;
-	return copy;
-}
-
 EngineMessage move_game_piece(Game *game, int src_x, int src_y, int dst_x, int dst_y){
 	if(!game) return INVALID_ARGUMENT;
-	GamePiece *piece = game->board[src_y][src_x];
+	GamePiece *piece = get_game_piece(game, src_x, src_y);
 	if(!piece) return ILLEGAL_MOVE;
 	if(dst_x < 0 || dst_x > BOARD_SIZE-1 || dst_y < 0 || dst_y > BOARD_SIZE-1){
 		return INVALID_ARGUMENT;
@@ -178,153 +130,205 @@ EngineMessage move_game_piece(Game *game, int src_x, int src_y, int dst_x, int d
 	/* Make sure piece is the same color as current player */
 	if(game->player_color[game->current_player] != piece->color) return ILLEGAL_MOVE;
 
-	int result = is_legal_move(game, piece, dst_x, dst_y);
-	if(!result){
-		return ILLEGAL_MOVE;
-	} else if (result == -1) {
-		return MALLOC_FAILURE;
-	}
+	if(!is_legal_move(game, piece, dst_x, dst_y)) return ILLEGAL_MOVE;
 
-	if(add_move_to_history(game, src_x, src_y, dst_x, dst_y) != SUCCESS) return MALLOC_FAILURE;
+	add_move_to_history(game, src_x, src_y, dst_x, dst_y);
 	move_piece_to_position(game, piece, dst_x, dst_y);
 	/* Determine if moving the piece ended with check state for enemy king */
-	game->current_player = !game->current_player;
+	switch_current_player(game);
 	game->check = is_in_check_state(game);
-	int game_over = is_game_over(game);
-	if(game_over == -1){
-		return MALLOC_FAILURE;
-	} else if (game_over == 1) {
-		return GAME_OVER;
-	}
+	if(is_game_over(game)) return GAME_OVER;
 
 	return SUCCESS;
 }
 
-EngineMessage undo_move(Game *game, GameMove **removed_move){
+EngineMessage undo_move(Game *game, GameMove *removed_move){
 	if(!game) return INVALID_ARGUMENT;
 
-	if(spArrayListIsEmpty(game->removed_pieces)) return EMPTY_HISTORY;
+	if(game->history_count == 0) return EMPTY_HISTORY;
 
-	GameMove *move = spArrayListGetFirst(game->move_history);
-	spArrayListRemoveFirst(game->move_history);
-	GamePiece *removed_piece = spArrayListGetFirst(game->removed_pieces);
-	spArrayListRemoveFirst(game->removed_pieces);
+	HistoryEntry *entry = &game->history[game->history_last];
+	game->history_last = (game->history_last + HISTORY_SIZE - 1) % HISTORY_SIZE;
+	game->history_count--;
+	GameMove move;
+	unpack_move(entry->move, &move);
 
-	/* Restore previous state */
-	if(removed_piece){
-		SPArrayList *pieces_set = (removed_piece->color == WHITE) ?
-			game->white_pieces : game->black_pieces;
-		spArrayListAddLast(pieces_set, removed_piece);
-	}
+	/* Restore previous state, the removed piece goes back to the end of its list */
 	move_piece_to_position(game,
-			game->board[move->dst_y][move->dst_x],
-			move->src_x,
-			move->src_y);
-	game->board[move->dst_y][move->dst_x] = removed_piece;
+			get_game_piece(game, move.dst_x, move.dst_y),
+			move.src_x,
+			move.src_y);
+	if(entry->move & MOVE_CAPTURE){
+		GamePiece *removed_piece = &entry->removed_piece;
+		insert_game_piece(game, removed_piece, game->piece_count[removed_piece->color]);
+	}
 	game->check = is_in_check_state(game);
-	game->current_player = !game->current_player;
+	switch_current_player(game);
 
 	*removed_move = move;
 	return SUCCESS;
 }
 
-EngineMessage get_possible_moves(SPArrayList **moves, Game *game, GamePiece *piece){
-	*moves = NULL;
+Move pack_move(Game *game, GameMove *move){
+	GamePiece *piece = get_game_piece(game, move->src_x, move->src_y);
+	GamePiece *target = get_game_piece(game, move->dst_x, move->dst_y);
+	int capture = piece && target && target->color != piece->color;
+	return MOVE(SQUARE(move->src_x, move->src_y), SQUARE(move->dst_x, move->dst_y),
+			capture ? MOVE_CAPTURE : 0);
+}
+
+void unpack_move(Move move, GameMove *unpacked){
+	unpacked->src_x = SQUARE_X(MOVE_SRC(move));
+	unpacked->src_y = SQUARE_Y(MOVE_SRC(move));
+	unpacked->dst_x = SQUARE_X(MOVE_DST(move));
+	unpacked->dst_y = SQUARE_Y(MOVE_DST(move));
+}
+
+void make_move(Game *game, Move move, MoveUndo *undo){
+	move_in_place(game, move, undo);
+	game->check = is_in_check_state(game);
+}
+
+void move_in_place(Game *game, Move move, MoveUndo *undo){
+	int src = MOVE_SRC(move), dst = MOVE_DST(move);
+	int index = game->squares[SQUARE_Y(dst)][SQUARE_X(dst)];
+	undo->move = move;
+	undo->captured_index = NO_PIECE;
+	undo->check = game->check;
+
+	if(index != NO_PIECE){
+		/* Remember captured piece and its position in its list so it can be restored in place */
+		Color color = index / ARRAY_SIZE;
+		undo->captured_index = index % ARRAY_SIZE;
+		undo->captured_piece = game->pieces[color][undo->captured_index];
+		remove_game_piece_at(game, color, undo->captured_index);
+	}
+	move_piece_to_position(game, get_game_piece(game, SQUARE_X(src), SQUARE_Y(src)), SQUARE_X(dst), SQUARE_Y(dst));
+	switch_current_player(game);
+}
+
+void unmake_move(Game *game, MoveUndo *undo){
+	int src = MOVE_SRC(undo->move), dst = MOVE_DST(undo->move);
+	move_piece_to_position(game, get_game_piece(game, SQUARE_X(dst), SQUARE_Y(dst)), SQUARE_X(src), SQUARE_Y(src));
+
+	if(undo->captured_index != NO_PIECE){
+		insert_game_piece(game, &undo->captured_piece, undo->captured_index);
+	}
+
+	switch_current_player(game);
+	game->check = undo->check;
+}
+
+EngineMessage get_possible_moves(GameMove *moves, int *count, Game *game, GamePiece *piece){
+	*count = 0;
 	if(!game) return INVALID_ARGUMENT;
 	if(!piece || piece->color != game->player_color[game->current_player])
 		return ILLEGAL_MOVE;
 
-	switch(piece->type){
-		case PAWN:
-			*moves = get_pawn_moves(game, piece);
-			break;
-		case ROOK:
-			*moves = get_rook_moves(game, piece);
-			break;
-		case KNIGHT:
-			*moves = get_knight_moves(game, piece);
-			break;
-		case BISHOP:
-			*moves = get_bishop_moves(game, piece);
-			break;
-		case QUEEN:
-			*moves = get_queen_moves(game, piece);
-			break;
-		case KING:
-			*moves = get_king_moves(game, piece);
-			break;
+	LegalityInfo info;
+	compute_legality_info(game, piece->color, &info);
+	Move packed_moves[MAX_PIECE_MOVES];
+	*count = get_piece_moves(game, piece, &info, packed_moves);
+	for(int i = 0; i < *count; i++) unpack_move(packed_moves[i], &moves[i]);
+	return SUCCESS;
+}
+
+int get_all_possible_moves(Game *game, Move *moves){
+	Color color = game->player_color[game->current_player];
+	/* Compute checks and pins once, then filter the moves of each piece against them */
+	LegalityInfo info;
+	compute_legality_info(game, color, &info);
+	int count = 0;
+	for (int i = 0; i < game->piece_count[color]; ++i) {
+		count += get_piece_moves(game, &game->pieces[color][i], &info, moves + count);
 	}
+	return count;
+}
 
-	return (*moves) ? SUCCESS : MALLOC_FAILURE;
+Bitboard get_attackers(Game *game, int sq, Color color, Bitboard occupied){
+	Bitboard *pieces = game->pieces_bb[color];
+	Bitboard queens = pieces[QUEEN];
+	/* A pawn threatens sq iff a pawn of the opposite direction on sq would threaten it */
+	return (pawn_attacks(sq, (color == WHITE) ? -1 : 1) & pieces[PAWN]) |
+		(knight_attacks(sq) & pieces[KNIGHT]) |
+		(king_attacks(sq) & pieces[KING]) |
+		(rook_attacks(sq, occupied) & (pieces[ROOK] | queens)) |
+		(bishop_attacks(sq, occupied) & (pieces[BISHOP] | queens));
 }
 
 int is_piece_threatened_after_move(Game *game, GamePiece *piece, GameMove *move){
-	Game *copy = copy_game(game);
-	if(!copy) return -1;
-	SPArrayList *enemy_pieces = (piece->color == WHITE) ?
-		copy->black_pieces : copy->white_pieces;
-
-	/* Get copy of piece at given position */
-	GamePiece *piece_copy = copy->board[piece->pos_y][piece->pos_x];
-	/* Get copy of piece to be moved */
-	GamePiece *src_piece_copy = copy->board[move->src_y][move->src_x];
-
-	/* Move copied source piece to move destination */
-	if(is_occupied_position(copy, move->dst_x, move->dst_y)){
-		GamePiece *dst_piece = copy->board[move->dst_y][move->dst_x];
-		remove_game_piece(copy, dst_piece);
-		free(dst_piece);
-	}
-	move_piece_to_position(copy, src_piece_copy, move->dst_x, move->dst_y);
-	copy->current_player = !copy->current_player;
-
-	/* Iterate through all enemy pieces and check if they threaten given piece */
-	for(int i = 0; i < spArrayListSize(enemy_pieces); i++){
-		GamePiece *temp = (GamePiece *)spArrayListGetAt(enemy_pieces, i);
-		if(is_legal_move(copy, temp, piece_copy->pos_x, piece_copy->pos_y)){
-			destroy_game(copy);
-			return 1;
-		}
-	}
-	destroy_game(copy);
-	return 0;
+	/* Pieces may be shifted in their lists by the move, so find the piece by its position */
+	Color enemy = !piece->color;
+	int moved = piece == get_game_piece(game, move->src_x, move->src_y);
+	Bitboard piece_bb = moved ? SQUARE_BB(SQUARE(move->dst_x, move->dst_y)) :
+		SQUARE_BB(SQUARE(piece->pos_x, piece->pos_y));
+	MoveUndo undo;
+	LegalityInfo info;
+
+	/* Try the move in place and revert it once enemy pieces have been checked */
+	move_in_place(game, pack_move(game, move), &undo);
+	int threatened = 0;
+
+	/* Only enemy pieces attacking the piece may capture it, if the capture is legal */
+	Bitboard attackers = get_attackers(game, bb_first(piece_bb), enemy, game->occupied_bb);
+	if(attackers) compute_legality_info(game, enemy, &info);
+	while(attackers && !threatened){
+		int sq = bb_pop_first(&attackers);
+		GamePiece *attacker = get_game_piece(game, SQUARE_X(sq), SQUARE_Y(sq));
+		threatened = (get_legal_targets(game, attacker, &info) & piece_bb) != 0;
+	}
+	unmake_move(game, &undo);
+	return threatened;
+}
+
+int has_any_legal_move(Game *game){
+	if(game->has_legal_move >= 0 && game->legal_move_key == game->hash) return game->has_legal_move;
+	Color color = game->player_color[game->current_player];
+	LegalityInfo info;
+	compute_legality_info(game, color, &info);
+	int found = 0;
+	for(int i = 0; i < game->piece_count[color] && !found; i++){
+		found = get_legal_targets(game, &game->pieces[color][i], &info) != 0;
+	}
+	game->legal_move_key = game->hash;
+	game->has_legal_move = found;
+	return found;
 }
 
 int is_game_over(Game *game){
-	/* Check if current player has any possible move */
-	SPArrayList *pieces =
-		(game->player_color[game->current_player] == WHITE) ?
-		game->white_pieces : game->black_pieces;
-	for (int i = 0; i < spArrayListSize(pieces); ++i) {
-		SPArrayList *moves;
-		GamePiece *piece = (GamePiece *)spArrayListGetAt(pieces, i);
-		EngineMessage msg = get_possible_moves(&moves, game, piece);
-		/* Invalid argument message is not possible here */
-		if(msg == MALLOC_FAILURE) return -1;
-		if(spArrayListSize(moves) > 0){
-			spArrayListDestroy(moves);
-			return 0;
-		}
-		spArrayListDestroy(moves);
-	}
-	return 1;
+	return !has_any_legal_move(game);
 }
 
 EngineMessage restart_game(Game *game) {
-	for(int i = 0; i < BOARD_SIZE; i++){
-		for(int j = 0; j < BOARD_SIZE; j++){
-			game->board[i][j] = NULL;
-		}
-	}
-	spArrayListClear(game->black_pieces);
-	spArrayListClear(game->white_pieces);
-	spArrayListClear(game->move_history);
-	spArrayListClear(game->removed_pieces);
+	clear_board(game);
+	game->history_last = 0;
+	game->history_count = 0;
+	clear_search_results(game);
 
 	return init_game(game);
 }
+
+void clear_search_results(Game *game){
+	if(game->tt) clear_transposition_table(game->tt);
+}
+
+void set_shuffle_seed(unsigned int seed){
+	shuffle_seed = seed;
+	rng_seed(&shuffle_rng, seed);
+	shuffle_rng_seeded = 1;
+}
+
+unsigned int get_shuffle_seed(){
+	return shuffle_seed;
+}
+
 /******************************** Auxiliary functions ******************************/
 
+RngState *get_shuffle_rng(){
+	if(!shuffle_rng_seeded) set_shuffle_seed(shuffle_seed);
+	return &shuffle_rng;
+}
+
 int serialize_game(Game *game, FILE *out){
 	init_serializer(out);
 	int indent = 0;
@@ -374,7 +378,7 @@ int write_board(Game *game, FILE *out, int indent){
 		char *row_str = (char *)malloc(BOARD_SIZE+1);
 		if(!row_str) return 0;
 		for (int j = 0; j < BOARD_SIZE; j++) {
-			GamePiece *piece = game->board[BOARD_SIZE-1-i][j];
+			GamePiece *piece = get_game_piece(game, j, BOARD_SIZE-1-i);
 			row_str[j] = get_piece_repr(piece);
 		}
 		row_str[BOARD_SIZE] = '\0';
@@ -411,7 +415,7 @@ int read_content(Tag tag, Game *game){
 			if(game->mode == ONE_PLAYER){
 				Color user_color = atoi(content());
 				if(user_color == BLACK){
-					/* Need to flip current player */
+					/* Need to flip current player, key is computed once loading is done */
 					game->current_player = !game->current_player;
 					game->player_color[PLAYER1] = BLACK;
 					game->player_color[PLAYER2] = WHITE;
@@ -437,8 +441,7 @@ int read_board_row(Game *game, int row){
 		if (row_str[i] == '_') continue;
 		PieceType piece_type = get_piece_type(row_str[i]);
 		Color piece_color = get_piece_color(row_str[i]);
-		EngineMessage msg = add_game_piece(game, piece_type, piece_color, i, row);
-		if(msg == MALLOC_FAILURE) return 0;
+		if(add_game_piece(game, piece_type, piece_color, i, row) != SUCCESS) return 0;
 	}
 	return 1;
 }
@@ -470,49 +473,131 @@ Color get_piece_color(char repr){
 	}
 }
 
-GamePiece *create_game_piece(PieceType type, Color color, int pos_x, int pos_y){
-	GamePiece *piece = (GamePiece *)malloc(sizeof(GamePiece));
-	if(!piece) return NULL;
-	piece->type = type;
-	piece->color = color;
-	piece->pos_x = pos_x;
-	piece->pos_y = pos_y;
-	return piece;
+void clear_board(Game *game){
+	for(int i = 0; i < BOARD_SIZE; i++){
+		for(int j = 0; j < BOARD_SIZE; j++){
+			game->squares[i][j] = NO_PIECE;
+		}
+	}
+	for(int i = 0; i < COLOR_COUNT; i++){
+		for(int j = 0; j < PIECE_TYPE_COUNT; j++){
+			game->pieces_bb[i][j] = 0;
+		}
+		game->color_bb[i] = 0;
+		game->piece_count[i] = 0;
+	}
+	game->occupied_bb = 0;
+	game->hash = 0;
+	game->has_legal_move = -1;
+	game->material[WHITE] = 0;
+	game->material[BLACK] = 0;
+}
+
+void index_game_pieces(Game *game, Color color, int from){
+	for(int i = from; i < game->piece_count[color]; i++){
+		GamePiece *piece = &game->pieces[color][i];
+		game->squares[piece->pos_y][piece->pos_x] = color * ARRAY_SIZE + i;
+	}
+}
+
+void insert_game_piece(Game *game, GamePiece *piece, int index){
+	GamePiece *pieces = game->pieces[piece->color];
+	for(int i = game->piece_count[piece->color]; i > index; i--){
+		pieces[i] = pieces[i-1];
+	}
+	pieces[index] = *piece;
+	game->piece_count[piece->color]++;
+	index_game_pieces(game, piece->color, index);
+	toggle_piece_bitboards(game, &pieces[index]);
+}
+
+void remove_game_piece_at(Game *game, Color color, int index){
+	GamePiece *pieces = game->pieces[color];
+	game->squares[pieces[index].pos_y][pieces[index].pos_x] = NO_PIECE;
+	toggle_piece_bitboards(game, &pieces[index]);
+	game->piece_count[color]--;
+	for(int i = index; i < game->piece_count[color]; i++){
+		pieces[i] = pieces[i+1];
+	}
+	index_game_pieces(game, color, index);
+}
+
+void shuffle_game_pieces(Game *game, Color color){
+	GamePiece *pieces = game->pieces[color];
+	int count = game->piece_count[color];
+	RngState *rng = get_shuffle_rng();
+	/* Same sequence of swaps the piece lists were shuffled with, so a seed keeps ordering pieces as before */
+	for(int i = 0; i < count-1; i++){
+		int j = i + rng_next(rng) / (RNG_MAX / (count-i) + 1);
+		GamePiece piece = pieces[j];
+		pieces[j] = pieces[i];
+		pieces[i] = piece;
+	}
+	index_game_pieces(game, color, 0);
+}
+
+void toggle_piece_bitboards(Game *game, GamePiece *piece){
+	Bitboard bb = SQUARE_BB(SQUARE(piece->pos_x, piece->pos_y));
+	game->pieces_bb[piece->color][piece->type] ^= bb;
+	game->color_bb[piece->color] ^= bb;
+	game->occupied_bb ^= bb;
+	game->hash ^= zobrist_piece_key(piece->color, piece->type, SQUARE(piece->pos_x, piece->pos_y));
+	/* Piece was placed iff its bit is now set */
+	game->material[piece->color] += (game->occupied_bb & bb) ?
+		piece_values[piece->type] : -piece_values[piece->type];
+}
+
+void switch_current_player(Game *game){
+	game->current_player = !game->current_player;
+	game->hash ^= zobrist_side_key();
+}
+
+void set_player_colors(Game *game, Color player1_color){
+	Color previous_color = game->player_color[game->current_player];
+	game->player_color[PLAYER1] = player1_color;
+	game->player_color[PLAYER2] = !player1_color;
+	if(game->player_color[game->current_player] != previous_color){
+		game->hash ^= zobrist_side_key();
+	}
+}
+
+ZobristKey compute_hash(Game *game){
+	ZobristKey hash = 0;
+	for(int color = 0; color < COLOR_COUNT; color++){
+		for(int type = 0; type < PIECE_TYPE_COUNT; type++){
+			Bitboard pieces = game->pieces_bb[color][type];
+			while(pieces) hash ^= zobrist_piece_key(color, type, bb_pop_first(&pieces));
+		}
+	}
+	if(game->player_color[game->current_player] == BLACK) hash ^= zobrist_side_key();
+	return hash;
 }
 
 EngineMessage init_game(Game *game){
 	/* Create all pieces and place them on the board */
 	EngineMessage msg;
 	game->current_player = (game->player_color[PLAYER1] == WHITE) ? PLAYER1 : PLAYER2;
+	game->hash = compute_hash(game);
 	msg = add_game_pieces_set(game, WHITE);
-	spArrayListShuffle(game->white_pieces);
+	shuffle_game_pieces(game, WHITE);
 	if(msg != SUCCESS) return msg;
 	msg = add_game_pieces_set(game, BLACK);
-	spArrayListShuffle(game->black_pieces);
+	shuffle_game_pieces(game, BLACK);
 	return msg;
 }
 
 EngineMessage add_game_piece(Game *game, PieceType type, Color color, int pos_x, int pos_y){
-	GamePiece *piece = create_game_piece(type, color, pos_x, pos_y);
-	if(!piece) return MALLOC_FAILURE;
-	SPArrayList *piece_set = (color == WHITE) ? game->white_pieces : game->black_pieces;
-	spArrayListAddLast(piece_set, piece); /* cannot fail on a new board */
-	game->board[pos_y][pos_x] = piece;
+	if(game->piece_count[color] == ARRAY_SIZE) return INVALID_ARGUMENT;
+	GamePiece piece = {type, color, pos_y, pos_x};
+	insert_game_piece(game, &piece, game->piece_count[color]);
 	return SUCCESS;
 }
 
 void remove_game_piece(Game *game, GamePiece *piece){
 	if(!piece) return;
 
-	/* Remove piece from list of game pieces */
-	if(piece->color == WHITE){
-		spArrayListRemoveItem(game->white_pieces, piece);
-	} else {
-		spArrayListRemoveItem(game->black_pieces, piece);
-	}
-
-	/* Remove piece from game board */
-	game->board[piece->pos_y][piece->pos_x] = NULL;
+	/* Remove piece from list of game pieces and from game board */
+	remove_game_piece_at(game, piece->color, game->squares[piece->pos_y][piece->pos_x] % ARRAY_SIZE);
 }
 
 EngineMessage add_game_pieces_set(Game *game, Color color){
@@ -546,7 +631,7 @@ EngineMessage add_game_pieces_set(Game *game, Color color){
 }
 
 int is_occupied_position(Game *game, int pos_x, int pos_y){
-	return game->board[pos_y][pos_x] != NULL;
+	return (game->occupied_bb & SQUARE_BB(SQUARE(pos_x, pos_y))) != 0;
 }
 
 int is_valid_position(int pos_x, int pos_y){
@@ -555,460 +640,253 @@ int is_valid_position(int pos_x, int pos_y){
 
 int is_legal_move(Game *game, GamePiece *piece, int pos_x, int pos_y){
 	if(!is_valid_position(pos_x, pos_y)) return 0;
-	/* If target position is occupied, make sure target piece is of different color */
-	GamePiece *target_piece = game->board[pos_y][pos_x];
-	if(target_piece && target_piece->color == piece->color) return 0;
-
-	/* Handle each piece type according to game rules */
-	switch(piece->type){
-		case PAWN:
-			if(!is_legal_pawn_move(game, piece, pos_x, pos_y)) return 0;
-			break;
-		case ROOK:
-			if(!is_legal_rook_move(game, piece, pos_x, pos_y)) return 0;
-			break;
-		case KNIGHT:
-			if(!is_legal_knight_move(piece, pos_x, pos_y)) return 0;
-			break;
-		case BISHOP:
-			if(!is_legal_bishop_move(game, piece, pos_x, pos_y)) return 0;
-			break;
-		case QUEEN:
-			if(!is_legal_queen_move(game, piece, pos_x, pos_y)) return 0;
-			break;
-		case KING:
-			if(!is_legal_king_move(piece, pos_x, pos_y)) return 0;
-			break;
-	}
-
-	/* Make sure moving the piece doesn't end with a check state for allied king */
-	int result;
-	if(target_piece && target_piece->type == KING){
-		/* Prevent loop, allied check is impossible in this state */
-		result = 0;
-	} else {
-		result = is_check_state_created_allied(game, piece, pos_x, pos_y);
-	}
-	if(result){
-		return 0;
-	} else if (result == -1) {
-		return -1;
+	LegalityInfo info;
+	compute_legality_info(game, piece->color, &info);
+	return (get_legal_targets(game, piece, &info) & SQUARE_BB(SQUARE(pos_x, pos_y))) != 0;
+}
+
+void compute_legality_info(Game *game, Color color, LegalityInfo *info){
+	Bitboard king_bb = game->pieces_bb[color][KING];
+	info->checkers = 0;
+	info->pinned = 0;
+	info->pinners = 0;
+	info->king_danger = 0;
+	info->check_mask = ~(Bitboard)0;
+	/* Capturing the enemy king is always allowed, allied check is impossible in this state */
+	info->enemy_king = game->pieces_bb[!color][KING];
+	if(!king_bb){
+		info->king_sq = -1;
+		return;
+	}
+	info->king_sq = bb_first(king_bb);
+
+	/* Collect squares attacked by enemy pieces, looking through allied king so it can't
+	 * step back along the ray of a checking piece */
+	Bitboard occupied = game->occupied_bb ^ king_bb;
+	for(int i = 0; i < game->piece_count[!color]; i++){
+		GamePiece *temp = &game->pieces[!color][i];
+		Bitboard attacks = get_piece_attacks(temp, occupied);
+		info->king_danger |= attacks;
+		if(attacks & king_bb) info->checkers |= SQUARE_BB(SQUARE(temp->pos_x, temp->pos_y));
+	}
+
+	/* A single check must be captured or blocked, only the king may escape a double check */
+	if(info->checkers){
+		info->check_mask = 0;
+		if(bb_count(info->checkers) == 1){
+			int checker_sq = bb_first(info->checkers);
+			info->check_mask = info->checkers | squares_between(info->king_sq, checker_sq);
+		}
 	}
 
-	return 1;
-}
-
-int is_legal_pawn_move(Game *game, GamePiece *piece, int pos_x, int pos_y){
-	/* Determine which direction pawn should move */
-	int direction = (piece->color == WHITE) ? 1 : -1;
-
-	/* Make sure pawn is moving exactly 1 or 2 rows in the correct direction */
-	if(pos_y != piece->pos_y + direction*1 && pos_y != piece->pos_y + direction*2) return 0;
-
-	if(pos_y == piece->pos_y + direction*1){
-		/* Make sure pawn is moving no more than 1 column away from current position */
-		if(piece->pos_x == pos_x){
-			/* Pawn stays in same column, target position must be unoccupied */
-			if (is_occupied_position(game, pos_x, pos_y)) return 0;
-		} else if (abs(pos_x - piece->pos_x) > 1) {
-			/* Pawn is trying to move more than 1 column away from current position */
-			return 0;
-		} else {
-			/* Pawn is moving diagonally */
-			/* Position must be occupied by a piece with the other color */
-			GamePiece *target_piece = game->board[pos_y][pos_x];
-			if(!target_piece || piece->color == target_piece->color) return 0;
+	/* An allied piece is pinned if it is the only piece between allied king and an enemy
+	 * sliding piece that would otherwise attack the king */
+	Bitboard queens = game->pieces_bb[!color][QUEEN];
+	Bitboard snipers =
+		(rook_attacks(info->king_sq, 0) & (game->pieces_bb[!color][ROOK] | queens)) |
+		(bishop_attacks(info->king_sq, 0) & (game->pieces_bb[!color][BISHOP] | queens));
+	while(snipers){
+		int sniper_sq = bb_pop_first(&snipers);
+		Bitboard blockers = squares_between(info->king_sq, sniper_sq) & game->occupied_bb;
+		if(bb_count(blockers) == 1 && (blockers & game->color_bb[color])){
+			info->pinned |= blockers;
+			info->pinners |= SQUARE_BB(sniper_sq);
 		}
-	} else {
-		/* Pawn is moving 2 rows, position must be initial position */
-		int init_position = (piece->color == WHITE) ? 1 : BOARD_SIZE - 2;
-		if(piece->pos_y != init_position) return 0;
-		/* Pawn cannot jump above another piece */
-		if(is_occupied_position(game, piece->pos_x, piece->pos_y + direction)) return 0;
-		/* Pawn stays in same column, target position must be unoccupied */
-		if (piece->pos_x != pos_x) return 0;
-		if (is_occupied_position(game, pos_x, pos_y)) return 0;
 	}
-	return 1;
 }
 
-int is_legal_rook_move(Game *game, GamePiece *piece, int pos_x, int pos_y){
-	/* Make sure rook is moving in a straight line */
-	if(pos_x != piece->pos_x && pos_y != piece->pos_y) return 0;
+Bitboard get_legal_targets(Game *game, GamePiece *piece, LegalityInfo *info){
+	Bitboard targets = get_pseudo_legal_targets(game, piece);
+	if(info->king_sq < 0) return targets;
+	if(piece->type == KING) return targets & (~info->king_danger | info->enemy_king);
 
-	/* Make sure no other pieces are inbetween */
-	if (pos_x == piece->pos_x) {
-		if (piece->pos_y < pos_y) {
-			for(int i = piece->pos_y + 1; i < pos_y; i++){
-				if(is_occupied_position(game, pos_x, i)) return 0;
-			}
-		} else {
-			for(int i = pos_y + 1; i < piece->pos_y; i++){
-				if(is_occupied_position(game, pos_x, i)) return 0;
-			}
-		}
-	} else {
-		if (piece->pos_x < pos_x) {
-			for(int i = piece->pos_x + 1; i < pos_x; i++){
-				if(is_occupied_position(game, i, pos_y)) return 0;
-			}
-		} else {
-			for(int i = pos_x + 1; i < piece->pos_x; i++){
-				if(is_occupied_position(game, i, pos_y)) return 0;
+	Bitboard allowed = info->check_mask;
+	int sq = SQUARE(piece->pos_x, piece->pos_y);
+	if(info->pinned & SQUARE_BB(sq)){
+		/* Pinned piece may only move along the line between allied king and its pinner */
+		Bitboard pinners = info->pinners;
+		while(pinners){
+			int pinner_sq = bb_pop_first(&pinners);
+			Bitboard line = squares_between(info->king_sq, pinner_sq);
+			if(line & SQUARE_BB(sq)){
+				allowed &= line | SQUARE_BB(pinner_sq);
+				break;
 			}
 		}
 	}
-	return 1;
-}
-
-int is_legal_knight_move(GamePiece *piece, int pos_x, int pos_y){
-	/* Make sure knight is moving at least 1 step in either direction */
-	if(pos_x == piece->pos_x || pos_y == piece->pos_y) return 0;
-
-	/* Make sure sum of steps in both directions is 3 */
-	/* (so that it moves 1 step in one direction and 2 steps in the other direction) */
-	if(abs(pos_x - piece->pos_x) + abs(pos_y - piece->pos_y) != 3) return 0;
-
-	return 1;
+	return targets & (allowed | info->enemy_king);
 }
 
-int is_legal_bishop_move(Game *game, GamePiece *piece, int pos_x, int pos_y){
-	/* Make sure bishop is moving diagonally */
-	if(abs(pos_x - piece->pos_x) != abs(pos_y - piece->pos_y)) return 0;
-
-	/* Make sure there are no other pieces inbetween */
-	int direction_x = (piece->pos_x < pos_x) ? 1 : -1;
-	int direction_y = (piece->pos_y < pos_y) ? 1 : -1;
-	int dist = abs(piece->pos_x - pos_x);
-	for(int i = 1; i < dist; i++){
-		int cur_pos_x = piece->pos_x + direction_x * i;
-		int cur_pos_y = piece->pos_y + direction_y * i;
-		if(is_occupied_position(game, cur_pos_x, cur_pos_y)) return 0;
+Bitboard get_piece_attacks(GamePiece *piece, Bitboard occupied){
+	int sq = SQUARE(piece->pos_x, piece->pos_y);
+	switch(piece->type){
+		case PAWN:
+			return pawn_attacks(sq, (piece->color == WHITE) ? 1 : -1);
+		case ROOK:
+			return rook_attacks(sq, occupied);
+		case KNIGHT:
+			return knight_attacks(sq);
+		case BISHOP:
+			return bishop_attacks(sq, occupied);
+		case QUEEN:
+			return queen_attacks(sq, occupied);
+		case KING:
+			return king_attacks(sq);
 	}
-	return 1;
-}
-
-int is_legal_queen_move(Game *game, GamePiece *piece, int pos_x, int pos_y){
-	/* Queen can move in the same way as either a rook or a bishop */
-	return is_legal_rook_move(game, piece, pos_x, pos_y) ||
-		is_legal_bishop_move(game, piece, pos_x, pos_y);
+	return 0; /* unreachable */
 }
 
-int is_legal_king_move(GamePiece *piece, int pos_x, int pos_y){
-	/* Make sure king moves exactly one step in any direction */
-	int dist_x = abs(piece->pos_x - pos_x);
-	int dist_y = abs(piece->pos_y - pos_y);
-	if(dist_x > 1 || dist_y > 1 || dist_x + dist_y == 0) return 0;
+Bitboard get_pseudo_legal_targets(Game *game, GamePiece *piece){
+	int sq = SQUARE(piece->pos_x, piece->pos_y);
+	Bitboard enemy = game->color_bb[!piece->color];
+	Bitboard not_allied = ~game->color_bb[piece->color];
 
-	return 1;
+	/* Handle each piece type according to game rules */
+	switch(piece->type){
+		case PAWN:
+			{
+				/* Pawn captures diagonally, and only onto enemy pieces */
+				int direction = (piece->color == WHITE) ? 1 : -1;
+				Bitboard targets = pawn_attacks(sq, direction) & enemy;
+				/* Pawn moves forward onto unoccupied positions, 2 rows only from its initial position */
+				int pos_y = piece->pos_y + direction;
+				if(!is_valid_position(piece->pos_x, pos_y)
+						|| is_occupied_position(game, piece->pos_x, pos_y)) return targets;
+				targets |= SQUARE_BB(SQUARE(piece->pos_x, pos_y));
+				int init_position = (piece->color == WHITE) ? 1 : BOARD_SIZE - 2;
+				pos_y += direction;
+				if(piece->pos_y == init_position && !is_occupied_position(game, piece->pos_x, pos_y)){
+					targets |= SQUARE_BB(SQUARE(piece->pos_x, pos_y));
+				}
+				return targets;
+			}
+		case ROOK:
+			return rook_attacks(sq, game->occupied_bb) & not_allied;
+		case KNIGHT:
+			return knight_attacks(sq) & not_allied;
+		case BISHOP:
+			return bishop_attacks(sq, game->occupied_bb) & not_allied;
+		case QUEEN:
+			return queen_attacks(sq, game->occupied_bb) & not_allied;
+		case KING:
+			return king_attacks(sq) & not_allied;
+	}
+	return 0; /* unreachable */
 }
 
 int is_in_check_state(Game *game){
-	SPArrayList *same_color_pieces;
-	SPArrayList *enemy_pieces;
-	if(game->player_color[game->current_player] == WHITE){
-		same_color_pieces = game->white_pieces;
-		enemy_pieces = game->black_pieces;
-	} else {
-		same_color_pieces = game->black_pieces;
-		enemy_pieces = game->white_pieces;
-	}
-
-	GamePiece *allied_king = find_king_piece(same_color_pieces);
-	for (int i = 0; i < spArrayListSize(enemy_pieces); ++i) {
-		GamePiece *temp = (GamePiece *)spArrayListGetAt(enemy_pieces, i);
-		if(is_legal_move(game, temp, allied_king->pos_x, allied_king->pos_y)) return 1;
-	}
-	return 0;
+	return is_king_threatened(game, game->player_color[game->current_player]);
 }
 
-int is_check_state_created_allied(Game *game, GamePiece *piece, int pos_x, int pos_y){
-	SPArrayList *same_color_pieces = (piece->color == WHITE) ?
-		game->white_pieces : game->black_pieces;
-
-	GamePiece *king = find_king_piece(same_color_pieces);
-	GameMove *move = create_move(piece->pos_x, piece->pos_y, pos_x, pos_y);
-	if(!move) return -1;
-	int result = is_piece_threatened_after_move(game, king, move);
-	free(move);
-	return result;
+int is_king_threatened(Game *game, Color color){
+	Bitboard king_bb = game->pieces_bb[color][KING];
+	if(!king_bb) return 0;
+	return get_attackers(game, bb_first(king_bb), !color, game->occupied_bb) != 0;
 }
 
 void move_piece_to_position(Game *game, GamePiece *piece, int pos_x, int pos_y){
 	if(is_occupied_position(game, pos_x, pos_y)){
-		remove_game_piece(game, game->board[pos_y][pos_x]);
+		remove_game_piece(game, get_game_piece(game, pos_x, pos_y));
 	}
 
 	/* Remove piece from previous location */
-	game->board[piece->pos_y][piece->pos_x] = NULL;
+	int index = game->squares[piece->pos_y][piece->pos_x];
+	game->squares[piece->pos_y][piece->pos_x] = NO_PIECE;
+	toggle_piece_bitboards(game, piece);
 	/* Move piece to the given position */
 	piece->pos_y = pos_y;
 	piece->pos_x = pos_x;
-	game->board[pos_y][pos_x] = piece;
+	game->squares[pos_y][pos_x] = index;
+	toggle_piece_bitboards(game, piece);
 }
 
-GamePiece *find_king_piece(SPArrayList *set){
-	for(int i = 0; i < spArrayListSize(set); i++){
-		GamePiece *temp = (GamePiece *)spArrayListGetAt(set, i);
-		if(temp->type == KING) return temp;
-	}
-	return NULL; /* should not be reached */
+void add_move_to_history(Game *game, int src_x, int src_y, int dst_x, int dst_y){
+	GamePiece *piece = get_game_piece(game, dst_x, dst_y);
+	game->history_last = (game->history_last + 1) % HISTORY_SIZE;
+	if(game->history_count < HISTORY_SIZE) game->history_count++;
+	HistoryEntry *entry = &game->history[game->history_last];
+	entry->move = MOVE(SQUARE(src_x, src_y), SQUARE(dst_x, dst_y), piece ? MOVE_CAPTURE : 0);
+	if(piece) entry->removed_piece = *piece;
 }
 
-EngineMessage add_move_to_history(Game *game, int src_x, int src_y, int dst_x, int dst_y){
-	if(spArrayListIsFull(game->move_history)){
-		free(spArrayListGetLast(game->move_history));
-		spArrayListRemoveLast(game->move_history);
-		free(spArrayListGetLast(game->removed_pieces));
-		spArrayListRemoveLast(game->removed_pieces);
+int get_pawn_moves(Game *game, GamePiece *piece, LegalityInfo *info, Move *moves){
+	/* Add moves 1 row forward before moving 2 rows forward */
+	Bitboard targets = get_legal_targets(game, piece, info);
+	int direction = (piece->color == WHITE) ? 1 : -1;
+	int init_position = (piece->color == WHITE) ? 1 : BOARD_SIZE - 2;
+	Bitboard double_step = 0;
+	if(piece->pos_y == init_position){
+		double_step = targets & SQUARE_BB(SQUARE(piece->pos_x, piece->pos_y + direction*2));
 	}
-	GameMove *move = create_move(src_x, src_y, dst_x, dst_y);
-	if(!move) return MALLOC_FAILURE;
-	spArrayListAddFirst(game->move_history, move);
-	GamePiece *piece = game->board[dst_y][dst_x];
-	spArrayListAddFirst(game->removed_pieces, piece);
-	return SUCCESS;
+	int count = add_moves_to_targets(game, moves, 0, piece, targets & ~double_step, 0);
+	return add_moves_to_targets(game, moves, count, piece, double_step, 0);
 }
 
-GameMove *create_move(int src_x, int src_y, int dst_x, int dst_y){
-	GameMove *move = malloc(sizeof(GameMove));
-	if(!move) return NULL;
-	move->src_x = src_x;
-	move->src_y = src_y;
-	move->dst_x = dst_x;
-	move->dst_y = dst_y;
-	return move;
+int get_rook_moves(Game *game, GamePiece *piece, LegalityInfo *info, Move *moves){
+	return add_sliding_moves(game, moves, 0, piece, get_legal_targets(game, piece, info));
 }
 
-SPArrayList *get_pawn_moves(Game *game, GamePiece *piece){
-	SPArrayList *moves = spArrayListCreate(sizeof(GameMove), MAX_PAWN_MOVES);
-	if(!moves) return NULL;
-
-	int direction = (piece->color == WHITE) ? 1 : -1;
-	for(int i = -1; i <= 1; i++){
-		if(is_legal_move(game, piece, piece->pos_x+i, piece->pos_y + direction*1)){
-			GameMove *move = create_move(
-					piece->pos_x,
-					piece->pos_y,
-					piece->pos_x+i,
-					piece->pos_y + direction*1);
-			if(!move){
-				spArrayListDestroy(moves);
-				return NULL;
-			}
-			spArrayListAddLast(moves, move);
-		}
-	}
-	if(is_legal_move(game, piece, piece->pos_x, piece->pos_y + direction*2)){
-		GameMove *move = create_move(
-				piece->pos_x,
-				piece->pos_y,
-				piece->pos_x,
-				piece->pos_y + direction*2);
-		if(!move){
-			spArrayListDestroy(moves);
-			return NULL;
-		}
-		spArrayListAddLast(moves, move);
-	}
-	return moves;
-}
-
-SPArrayList *get_rook_moves(Game *game, GamePiece *piece){
-	SPArrayList *moves = spArrayListCreate(sizeof(GameMove), MAX_ROOK_MOVES);
-	if(!moves) return NULL;
-
-	/* Add moves along column */
-	int start_index = find_range_end(game, ROOK, piece->pos_x, piece->pos_y, 0, -1);
-	int end_index = find_range_end(game, ROOK, piece->pos_x, piece->pos_y, 0, 1);
-	/* TODO: Optimize for un-checked state if needed */
-	for(int i = start_index; i <= end_index; i++){
-		if(i == 0) continue;
-		if(is_legal_move(game, piece, piece->pos_x, piece->pos_y+i)){
-			GameMove *move = create_move(
-					piece->pos_x,
-					piece->pos_y,
-					piece->pos_x,
-					piece->pos_y+i);
-			if(!move){
-				spArrayListDestroy(moves);
-				return NULL;
-			}
-			spArrayListAddLast(moves, move);
-		}
-	}
-
-	/* Add moves along row */
-	start_index = find_range_end(game, ROOK, piece->pos_x, piece->pos_y, -1, 0);
-	end_index = find_range_end(game, ROOK, piece->pos_x, piece->pos_y, 1, 0);
-	for(int i = start_index; i <= end_index; i++){
-		if(i == 0) continue;
-		if(is_legal_move(game, piece, piece->pos_x+i, piece->pos_y)){
-			GameMove *move = create_move(
-					piece->pos_x,
-					piece->pos_y,
-					piece->pos_x+i,
-					piece->pos_y);
-			if(!move){
-				spArrayListDestroy(moves);
-				return NULL;
-			}
-			spArrayListAddLast(moves, move);
-		}
-	}
-	return moves;
-}
-
-SPArrayList *get_knight_moves(Game *game, GamePiece *piece){
-	SPArrayList *moves = spArrayListCreate(sizeof(GameMove), MAX_KNIGHT_MOVES);
-	if(!moves) return NULL;
-
-	for(int i = -2; i <= 2; i++){
-		if(i == 0) continue;
-		int j = (abs(i) == 1) ? 2 : 1;
-		if(is_legal_move(game, piece, piece->pos_x - j, piece->pos_y + i)){
-			GameMove *move = create_move(
-					piece->pos_x,
-					piece->pos_y,
-					piece->pos_x - j,
-					piece->pos_y + i);
-			if(!move){
-				spArrayListDestroy(moves);
-				return NULL;
-			}
-			spArrayListAddLast(moves, move);
-		}
-		if(is_legal_move(game, piece, piece->pos_x + j, piece->pos_y + i)){
-			GameMove *move = create_move(
-					piece->pos_x,
-					piece->pos_y,
-					piece->pos_x + j,
-					piece->pos_y + i);
-			if(!move){
-				spArrayListDestroy(moves);
-				return NULL;
-			}
-			spArrayListAddLast(moves, move);
-
-		}
-	}
-	return moves;
-}
-
-SPArrayList *get_bishop_moves(Game *game, GamePiece *piece){
-	SPArrayList *moves = spArrayListCreate(sizeof(GameMove), MAX_BISHOP_MOVES);
-	if(!moves) return NULL;
-
-	/* Add moves along upward diagonal */
-	int start_index = find_range_end(game, BISHOP, piece->pos_x, piece->pos_y, -1, -1);
-	int end_index = find_range_end(game, BISHOP, piece->pos_x, piece->pos_y, 1, 1);
-	for(int i = start_index; i <= end_index; i++){
-		if(i == 0) continue;
-		if(is_legal_move(game, piece, piece->pos_x + i, piece->pos_y + i)){
-			GameMove *move = create_move(
-					piece->pos_x,
-					piece->pos_y,
-					piece->pos_x+i,
-					piece->pos_y+i);
-			if(!move){
-				spArrayListDestroy(moves);
-				return NULL;
-			}
-			spArrayListAddLast(moves, move);
-		}
-	}
+int get_knight_moves(Game *game, GamePiece *piece, LegalityInfo *info, Move *moves){
+	return add_moves_to_targets(game, moves, 0, piece, get_legal_targets(game, piece, info), 0);
+}
 
-	/* Add moves along downward diagonal */
-	start_index = find_range_end(game, BISHOP, piece->pos_x, piece->pos_y, -1, 1);
-	end_index = find_range_end(game, BISHOP, piece->pos_x, piece->pos_y, 1, -1);
-	for(int i = start_index; i <= end_index; i++){
-		if(i == 0) continue;
-		if(is_legal_move(game, piece, piece->pos_x + i, piece->pos_y - i)){
-			GameMove *move = create_move(
-					piece->pos_x,
-					piece->pos_y,
-					piece->pos_x+i,
-					piece->pos_y-i);
-			if(!move){
-				spArrayListDestroy(moves);
-				return NULL;
-			}
-			spArrayListAddLast(moves, move);
-		}
-	}
-	return moves;
+int get_bishop_moves(Game *game, GamePiece *piece, LegalityInfo *info, Move *moves){
+	return add_sliding_moves(game, moves, 0, piece, get_legal_targets(game, piece, info));
 }
 
-SPArrayList *get_queen_moves(Game *game, GamePiece *piece){
-	SPArrayList *moves = spArrayListCreate(sizeof(GameMove), MAX_QUEEN_MOVES);
-	if(!moves) return NULL;
+int get_queen_moves(Game *game, GamePiece *piece, LegalityInfo *info, Move *moves){
+	return add_sliding_moves(game, moves, 0, piece, get_legal_targets(game, piece, info));
+}
 
-	SPArrayList *rook_moves = get_rook_moves(game, piece);
-	if(!rook_moves){
-		spArrayListDestroy(moves);
-		return NULL;
-	}
-	SPArrayList *bishop_moves = get_bishop_moves(game, piece);
-	if(!bishop_moves){
-		spArrayListDestroy(rook_moves);
-		spArrayListDestroy(moves);
-		return NULL;
+int get_king_moves(Game *game, GamePiece *piece, LegalityInfo *info, Move *moves){
+	/* Add moves column by column */
+	Bitboard targets = get_legal_targets(game, piece, info);
+	int count = 0;
+	for(int i = -1; i <= 1; i++){
+		if(!is_valid_position(piece->pos_x+i, piece->pos_y)) continue;
+		count = add_moves_to_targets(game, moves, count, piece, targets & FILE_BB(piece->pos_x+i), 0);
 	}
+	return count;
+}
 
-	for(int i = 0; i < spArrayListSize(rook_moves); i++){
-		spArrayListAddLast(moves, copy_move(spArrayListGetAt(rook_moves, i)));
-	}
-	for(int i = 0; i < spArrayListSize(bishop_moves); i++){
-		spArrayListAddLast(moves, copy_move(spArrayListGetAt(bishop_moves, i)));
+int get_piece_moves(Game *game, GamePiece *piece, LegalityInfo *info, Move *moves){
+	switch(piece->type){
+		case PAWN:
+			return get_pawn_moves(game, piece, info, moves);
+		case ROOK:
+			return get_rook_moves(game, piece, info, moves);
+		case KNIGHT:
+			return get_knight_moves(game, piece, info, moves);
+		case BISHOP:
+			return get_bishop_moves(game, piece, info, moves);
+		case QUEEN:
+			return get_queen_moves(game, piece, info, moves);
+		case KING:
+			return get_king_moves(game, piece, info, moves);
 	}
-	spArrayListDestroy(rook_moves);
-	spArrayListDestroy(bishop_moves);
-	return moves;
+	return 0; /* unreachable */
 }
 
-SPArrayList *get_king_moves(Game *game, GamePiece *piece){
-	SPArrayList *moves = spArrayListCreate(sizeof(GameMove), MAX_KING_MOVES);
-	if(!moves) return NULL;
+int add_sliding_moves(Game *game, Move *moves, int count, GamePiece *piece, Bitboard targets){
+	int sq = SQUARE(piece->pos_x, piece->pos_y);
+	Bitboard column = targets & FILE_BB(piece->pos_x);
+	Bitboard row = targets & RANK_BB(piece->pos_y);
+	Bitboard diagonal = targets & (ray_mask(sq, NORTH_EAST) | ray_mask(sq, SOUTH_WEST));
+	Bitboard anti_diagonal = targets & ~(column | row | diagonal);
 
-	for(int i = -1; i <= 1; i++){
-		for(int j = -1; j <= 1; j++){
-			if(i == 0 && j == 0) continue;
-			if(is_legal_move(game, piece, piece->pos_x+i, piece->pos_y+j)){
-				GameMove *move = create_move(
-						piece->pos_x,
-						piece->pos_y,
-						piece->pos_x+i,
-						piece->pos_y+j);
-				if(!move){
-					spArrayListDestroy(moves);
-					return NULL;
-				}
-				spArrayListAddLast(moves, move);
-			}
-		}
-	}
-	return moves;
+	/* Add moves along column and row, then along upward and downward diagonals */
+	count = add_moves_to_targets(game, moves, count, piece, column, 0);
+	count = add_moves_to_targets(game, moves, count, piece, row, 0);
+	count = add_moves_to_targets(game, moves, count, piece, diagonal, 0);
+	return add_moves_to_targets(game, moves, count, piece, anti_diagonal, 1);
 }
 
-int find_range_end(Game *game, PieceType type, int src_x, int src_y, int inc_x, int inc_y){
-	int i = inc_x, j = inc_y;
-	if(is_valid_position(src_x+i, src_y+j)){
-		/* Increment counters until board edge has been reached or we found a game piece,
-		whichever comes first */
-		while(is_valid_position(src_x+i, src_y+j)
-				&& !is_occupied_position(game, src_x+i, src_y+j)){
-			i += inc_x;
-			j += inc_y;
-		}
-	} else {
-		/* There are no possible moves in this direction */
-		i = -i;
-		j = -j;
-	}
-	/* Return index relevant to game piece type */
-	if(type == ROOK){
-		return (inc_x == 0) ? j : i;
-	} else {
-		return i;
+int add_moves_to_targets(Game *game, Move *moves, int count, GamePiece *piece, Bitboard targets, int descending){
+	int src = SQUARE(piece->pos_x, piece->pos_y);
+	Bitboard enemies = game->color_bb[!piece->color];
+	while(targets){
+		int sq = descending ? bb_pop_last(&targets) : bb_pop_first(&targets);
+		moves[count++] = MOVE(src, sq, (enemies & SQUARE_BB(sq)) ? MOVE_CAPTURE : 0);
 	}
+	return count;
 }
@@ -6,21 +6,37 @@
  * Summary of interface:
  * create_game        	 create new game instance
  * copy_game          	 copy an existing game instance
+ * get_game_piece     	 get the game piece on a given position
  * destroy_game       	 free all allocated memory and destroy game instance
  * move_game_piece    	 move a game piece from current place on board to another
  * undo_move          	 undo most recent move
+ * make_move          	 perform a legal move in place, without recording it in history
+ * unmake_move        	 revert a move performed by make_move
+ * set_player_colors  	 assign colors to players of an existing game
+ * pack_move          	 convert a move into its packed form
+ * unpack_move        	 convert a packed move into a move, e.g. for printing
+ * set_shuffle_seed   	 restart the sequence ordering the pieces of new games from a seed
  * get_possible_moves 	 get all possible moves for a given game piece
+ * get_all_possible_moves 	 get all possible moves of the current player
+ * get_attackers      	 get the pieces of a color threatening a given position
+ * has_any_legal_move 	 checks if the current player has any possible move
  * is_game_over       	 checks if the given game instance reached a final state
+ * clear_search_results 	 forget results of earlier searches kept with a game
  */
 #include <stdio.h>
-#include "array_list.h"
+#include "rng.h"
+#include "bitboard.h"
+#include "zobrist.h"
 #include "xml_serializer.h"
 #include "xml_parser.h"
 
 #define BOARD_SIZE 8
 #define ARRAY_SIZE 16
 #define PLAYER_COUNT 2
+#define COLOR_COUNT 2
+#define PIECE_TYPE_COUNT 6
 #define HISTORY_SIZE 6
+#define NO_PIECE -1
 
 #define MAX_PAWN_MOVES 4
 #define MAX_ROOK_MOVES 14
@@ -28,6 +44,8 @@
 #define MAX_BISHOP_MOVES 13
 #define MAX_QUEEN_MOVES 27
 #define MAX_KING_MOVES 8
+#define MAX_PIECE_MOVES MAX_QUEEN_MOVES
+#define MAX_MOVES 256
 
 typedef enum {
 	MALLOC_FAILURE,
@@ -66,17 +84,50 @@ typedef struct {
 	int pos_x;
 } GamePiece;
 
-/* Struct defining a game board with relevant properties */
+/* Move packed into 16 bits, used by the engine and the search: source square in the low six
+ * bits, target square in the next six and flags above them. Squares are bitboard squares */
+typedef uint16_t Move;
+
+#define MOVE_NONE 0 /* never a legal move, as source and target are the same */
+#define MOVE_CAPTURE 0x1000 /* move captures an enemy piece */
+#define MOVE_PROMOTION 0x2000 /* reserved, pawns are not promoted by the rules of this game */
+#define MOVE_SQUARES_MASK 0x0fff
+#define MOVE(src, dst, flags) ((Move)((src) | ((dst) << 6) | (flags)))
+#define MOVE_SRC(move) ((move) & 0x3f)
+#define MOVE_DST(move) (((move) >> 6) & 0x3f)
+
+/* Struct defining a single entry of the move history */
+typedef struct {
+	Move move;
+	GamePiece removed_piece; /* piece captured by the move, valid iff move is a capture */
+} HistoryEntry;
+
+struct TranspositionTable;
+struct Arena;
+
+/* Struct defining a game board with relevant properties. All of the position is stored inline
+ * and the pieces are referred to by index, so a game is copied by copying the struct */
 typedef struct {
-	GamePiece *board[BOARD_SIZE][BOARD_SIZE]; /* current game board */
-	SPArrayList *white_pieces, *black_pieces; /* lists representing white and black game pieces on the board */
-	SPArrayList *move_history; /* list to remember last 3 moves of each player */
-	SPArrayList *removed_pieces; /* list to remember last 3 removed pieces of each player */
+	GamePiece pieces[COLOR_COUNT][ARRAY_SIZE]; /* game pieces on the board of each color, in move generation order */
+	int piece_count[COLOR_COUNT]; /* number of game pieces of each color */
+	signed char squares[BOARD_SIZE][BOARD_SIZE]; /* index of the piece on each position, see get_game_piece */
+	HistoryEntry history[HISTORY_SIZE]; /* ring remembering last 3 moves of each player */
+	int history_last; /* index of most recent entry in history ring */
+	int history_count; /* number of entries in history ring */
+	Bitboard pieces_bb[COLOR_COUNT][PIECE_TYPE_COUNT]; /* squares occupied by each piece type, indexed by color */
+	Bitboard color_bb[COLOR_COUNT]; /* squares occupied by each color */
+	Bitboard occupied_bb; /* squares occupied by either color */
+	ZobristKey hash; /* Zobrist key of the board and the color to move */
+	ZobristKey legal_move_key; /* hash of the position last checked by has_any_legal_move */
+	int has_legal_move; /* result of has_any_legal_move for legal_move_key, -1 if none was checked */
+	int material[COLOR_COUNT]; /* sum of piece values of each color on the board */
 	Player current_player;
 	Color player_color[PLAYER_COUNT];
 	Mode mode;
 	int difficulty;
 	int check; /* determines whether last turn ended with a check */
+	struct TranspositionTable *tt; /* search results kept between moves, allocated by first search, not part of the position */
+	struct Arena *arena; /* memory of search threads, allocated by first threaded search, not part of the position */
 } Game;
 
 /* Struct defining a single game move from one position to another */
@@ -87,6 +138,29 @@ typedef struct {
 	int dst_y;
 } GameMove;
 
+/* Struct holding everything needed to revert a move performed by make_move */
+typedef struct {
+	Move move;
+	GamePiece captured_piece; /* piece removed from target position, valid iff captured_index != NO_PIECE */
+	int captured_index; /* index of captured piece in its color's list of pieces, NO_PIECE if none */
+	int check; /* check state before the move */
+} MoveUndo;
+
+/* Struct holding checks and pins of one side, computed once per position to filter
+ * pseudo legal moves of all of its pieces */
+typedef struct {
+	int king_sq; /* square of allied king, -1 if there is none */
+	Bitboard checkers; /* enemy pieces threatening allied king */
+	Bitboard check_mask; /* targets of non-king pieces resolving current check, all if none */
+	Bitboard pinned; /* allied pieces pinned to allied king */
+	Bitboard pinners; /* enemy sliding pieces pinning allied pieces */
+	Bitboard king_danger; /* positions threatened by enemy pieces, as seen through allied king */
+	Bitboard enemy_king; /* enemy king, which may always be captured */
+} LegalityInfo;
+
+/* Material value of each piece type, indexed by PieceType */
+extern const int piece_values[PIECE_TYPE_COUNT];
+
 /*
  * Creates a new game instance.
  * @param settings 	 struct containing settings set by the user for the created game
@@ -95,12 +169,22 @@ typedef struct {
 Game *create_game(GameSettings *settings);
 
 /*
- * Copies an existing game instance.
+ * Copies an existing game instance. The copy doesn't share search results with the game.
  * @param game 	 game to be copied
  * @return     	 pointer to the generated copy on success, NULL otherwise
  */
 Game *copy_game(Game *game);
 
+/*
+ * Get the game piece on a given position. The piece belongs to the game and is only valid
+ * until the next change to the pieces of its color.
+ * @param game  	 game instance
+ * @param pos_x 	 column of the position
+ * @param pos_y 	 row of the position
+ * @return      	 pointer to the piece on the position, NULL if it is empty
+ */
+GamePiece *get_game_piece(Game *game, int pos_x, int pos_y);
+
 /*
  * Save game instance into given XML file.
  * @param game 	 game instance
@@ -123,13 +207,6 @@ Game *load_game(FILE *in);
  */
 void destroy_game();
 
-/*
- * Copy given game move.
- * @param move 	 move to copy
- * @return     	 pointer to generated copy on success, NULL otherwise
- */
-GameMove *copy_move(GameMove *move);
-
 /*
  * Move a game piece from its current place to the given coordinates.
  * @param game  	 game instance
@@ -140,7 +217,6 @@ GameMove *copy_move(GameMove *move);
  * @return
  * INVALID_ARGUMENT 	 game == NULL or piece == NULL or coordinates out of bounds
  * ILLEGAL_MOVE     	 move is not a legal move as defined by chess rules
- * MALLOC_FAILURE   	 failed to allocate memory when checking if king move is valid
  * GAME_OVER        	 move succeeded and the game reached a final state
  * SUCCESS          	 otherwise
  */
@@ -149,50 +225,150 @@ EngineMessage move_game_piece(Game *game, int src_x, int src_y, int dst_x, int d
 /*
  * Undo most recent move in the game.
  * @param game         	 game instance
- * @param removed_move 	 variable to store removed move for printing later
+ * @param removed_move 	 variable to store removed move in for printing later
  * @return
  * INVALID_ARGUMENT 	 game == NULL
  * EMPTY_HISTORY    	 move history is empty
  * SUCCESS          	 otherwise
  */
-EngineMessage undo_move(Game *game, GameMove **removed_move);
+EngineMessage undo_move(Game *game, GameMove *removed_move);
+
+/*
+ * Assign colors to the players of an existing game, keeping the current player.
+ * @param game          	 game instance
+ * @param player1_color 	 color of PLAYER1, PLAYER2 gets the other color
+ */
+void set_player_colors(Game *game, Color player1_color);
+
+/*
+ * Restart the random sequence used to order the lists of pieces of created and loaded games,
+ * which decides between equally good moves of the computer. Games created after seeding with
+ * the same seed in the same order are identical. The sequence starts from DEFAULT_RNG_SEED
+ * unless this function is called.
+ * @param seed 	 seed of the sequence
+ */
+void set_shuffle_seed(unsigned int seed);
+
+/*
+ * Get the seed the random sequence ordering lists of pieces was last restarted from.
+ * @return 	 seed of the sequence
+ */
+unsigned int get_shuffle_seed();
+
+/*
+ * Pack given move of the current position, flagging it as a capture if its target is occupied
+ * by an enemy piece.
+ * @param game 	 game instance
+ * @param move 	 move to pack
+ * @return     	 packed move
+ */
+Move pack_move(Game *game, GameMove *move);
+
+/*
+ * Convert a packed move into source and target coordinates.
+ * @param move     	 packed move
+ * @param unpacked 	 variable to store the coordinates of the move in
+ */
+void unpack_move(Move move, GameMove *unpacked);
+
+/*
+ * Perform given move in place, without recording it in move history. Captured pieces are
+ * kept in the undo record so that the move can be reverted exactly, including the
+ * order of the lists of pieces.
+ * @precond     	 move is legal for the current player
+ * @param game  	 game instance
+ * @param move  	 move to perform
+ * @param undo  	 record to be filled with the information needed by unmake_move
+ */
+void make_move(Game *game, Move move, MoveUndo *undo);
+
+/*
+ * Revert a move performed by make_move. Moves must be reverted in reverse order.
+ * @param game 	 game instance
+ * @param undo 	 record filled by the matching make_move call
+ */
+void unmake_move(Game *game, MoveUndo *undo);
 
 /*
- * Get a list of all possible moves of a given game piece.
- * @param moves 	 array to be filled with possible moves, will be set to NULL on failure
+ * Get all possible moves of a given game piece, without allocating memory.
+ * @param moves 	 buffer of at least MAX_PIECE_MOVES moves to be filled with possible moves
+ * @param count 	 variable to store number of possible moves, set to 0 on failure
  * @param game  	 game instance
  * @param piece 	 game piece
  * @return
- * SUCCESS          	 given array was filled with possible moves
- * MALLOC_FAILURE   	 memory error occurred
+ * SUCCESS          	 given buffer was filled with possible moves
  * ILLEGAL_MOVE     	 piece is NULL or current player doesn't own it
  * INVALID_ARGUMENT 	 game is NULL
  */
-EngineMessage get_possible_moves(SPArrayList **moves, Game *game, GamePiece *piece);
+EngineMessage get_possible_moves(GameMove *moves, int *count, Game *game, GamePiece *piece);
+
+/*
+ * Get all possible moves of the current player, without allocating memory. Moves are
+ * ordered by the list of pieces of the current player.
+ * @precond     	 game != NULL
+ * @param game  	 game instance
+ * @param moves 	 buffer of at least MAX_MOVES moves to be filled with possible moves
+ * @return      	 number of possible moves
+ */
+int get_all_possible_moves(Game *game, Move *moves);
+
+/*
+ * Get the pieces of the given color threatening a position, by probing outward from it with
+ * the attacks of each piece type and intersecting them with the pieces of that type.
+ * @param game     	 game instance
+ * @param sq       	 threatened position, as a bitboard square
+ * @param color    	 color of the threatening pieces
+ * @param occupied 	 set of occupied positions blocking sliding pieces
+ * @return         	 set of threatening pieces
+ */
+Bitboard get_attackers(Game *game, int sq, Color color, Bitboard occupied);
 
 /*
  * Check if given game piece is threatened by enemy after performing given move.
  * @param game  	 game instance
  * @param piece 	 game piece
  * @param move  	 game move (possibly of a game piece different than given piece)
- * @return      	 -1 on memory failure, true if piece is threatened after move, false otherwise
+ * @return      	 true if piece is threatened after move, false otherwise
  */
 int is_piece_threatened_after_move(Game *game, GamePiece *piece, GameMove *move);
 
+/*
+ * Check if the current player has any possible move, stopping at the first piece that can
+ * move and without allocating memory. The result is remembered for the position until
+ * another one is checked.
+ * @param game 	 game instance
+ * @return     	 true iff current player has a possible move
+ */
+int has_any_legal_move(Game *game);
+
 /*
  * Determine whether the game has reached a final state.
  * @param game 	 game instance
- * @return     	 true iff game is over, -1 on memory failure
+ * @return     	 true iff game is over
  */
 int is_game_over(Game *game);
 
 EngineMessage restart_game(Game *game);
 
+/*
+ * Forget results of earlier searches kept with the game, so a new game played in the same
+ * instance doesn't search with entries of the previous one.
+ * @param game 	 game instance
+ */
+void clear_search_results(Game *game);
+
 /*******************************************************************************************/
 /**************** Auxiliary functions - should not be called outside this module ***********/
 /*******************************************************************************************/
 
 
+/*
+ * Get the generator state ordering the lists of pieces of new games, seeding it with
+ * DEFAULT_RNG_SEED if it wasn't seeded yet.
+ * @return 	 generator state
+ */
+RngState *get_shuffle_rng();
+
 /*
  * Serialize given game instance into an XML tree and write it to given file.
  * @param game 	 game instance
@@ -214,7 +390,7 @@ int write_board(Game *game, FILE *out, int indent);
  * Read tag contents into game instance.
  * @param tag  	 last tag that was read
  * @param game 	 game instance
- * @return     	 true on success, false on malloc failure
+ * @return     	 true on success, false if the board can't be read
  */
 int read_content(Tag tag, Game *game);
 
@@ -222,7 +398,7 @@ int read_content(Tag tag, Game *game);
  * Read board row contents into game instance.
  * @param game 	 game instance
  * @param row  	 row index
- * @return     	 true if read succeeded, false on malloc failure
+ * @return     	 true if read succeeded, false if a color has too many pieces
  */
 int read_board_row(Game *game, int row);
 
@@ -241,23 +417,83 @@ PieceType get_piece_type(char repr);
 Color get_piece_color(char repr);
 
 /*
- * Create a single game piece of the given type and color and initialize its position
- * to the given coordinates.
- * @param type  	 type of the piece to be created
- * @param color 	 color of the piece to be created
- * @param pos_x 	 column position of the piece on the board
- * @param pos_y 	 row position of the piece on the board
- * @return      	 pointer to the newly created piece on success, NULL otherwise
+ * Remove all game pieces from the board, emptying the lists of pieces and clearing its
+ * bitboards. Move history is not affected.
+ * @precond    	 game != NULL
+ * @param game 	 game instance
+ */
+void clear_board(Game *game);
+
+/*
+ * Point the positions of the pieces of given color to their index in the list of pieces,
+ * starting from a given index. Used after the list has been shifted.
+ * @precond     	 game != NULL
+ * @param game  	 game instance
+ * @param color 	 color of the pieces
+ * @param from  	 index of the first piece to be updated
+ */
+void index_game_pieces(Game *game, Color color, int from);
+
+/*
+ * Insert a copy of given game piece into the list of pieces of its color at the given index,
+ * and place it on its position on the board.
+ * @precond     	 game != NULL, list of pieces isn't full and position is empty
+ * @param game  	 game instance
+ * @param piece 	 game piece to be inserted
+ * @param index 	 index to insert the piece at, pieces from this index on are shifted
+ */
+void insert_game_piece(Game *game, GamePiece *piece, int index);
+
+/*
+ * Remove the game piece at the given index of the list of pieces of given color from the
+ * list and from the board.
+ * @precond     	 game != NULL
+ * @param game  	 game instance
+ * @param color 	 color of the piece
+ * @param index 	 index of the piece, pieces after it are shifted
+ */
+void remove_game_piece_at(Game *game, Color color, int index);
+
+/*
+ * Reorder the list of pieces of given color using the random sequence of get_shuffle_rng.
+ * @precond     	 game != NULL
+ * @param game  	 game instance
+ * @param color 	 color of the pieces
+ */
+void shuffle_game_pieces(Game *game, Color color);
+
+/*
+ * Flip the bits representing given game piece in the game bitboards and position key, and
+ * add or subtract its value from the material of its color accordingly.
+ * Used for both placing a piece on its current position and removing it from there.
+ * @precond     	 game != NULL
+ * @param game  	 game instance
+ * @param piece 	 game piece
+ */
+void toggle_piece_bitboards(Game *game, GamePiece *piece);
+
+/*
+ * Pass the turn to the other player and update the position key accordingly.
+ * @precond    	 game != NULL
+ * @param game 	 game instance
  */
-GamePiece *create_game_piece(PieceType type, Color color, int pos_x, int pos_y);
+void switch_current_player(Game *game);
+
+/*
+ * Compute the Zobrist key of the current position from scratch.
+ * @precond    	 game != NULL
+ * @param game 	 game instance
+ * @return     	 key of the pieces on the board and the color to move
+ */
+ZobristKey compute_hash(Game *game);
 
 /*
  * Initialize game board with all of the pieces in their default slots.
  * @precond    	 game != NULL
  * @param game 	 existing game board
  * @return
- * MALLOC_FAILURE 	 if allocating memory failed
- * SUCCESS        	 otherwise
+ * INVALID_ARGUMENT 	 if board already has pieces a color can't have more of
+ * SUCCESS          	 otherwise
  */
 EngineMessage init_game(Game *game);
 
@@ -271,8 +507,8 @@ EngineMessage init_game(Game *game);
  * @param pos_x 	 column position of the piece on the board
  * @param pos_y 	 row position of the piece on the board
  * @return
- * MALLOC_FAILURE 	 if allocating memory failed
- * SUCCESS        	 otherwise
+ * INVALID_ARGUMENT 	 if given color already has ARRAY_SIZE pieces
+ * SUCCESS          	 otherwise
  */
 EngineMessage add_game_piece(Game *game, PieceType type, Color color, int pos_x, int pos_y);
 
@@ -290,8 +526,8 @@ void remove_game_piece(Game *game, GamePiece *piece);
  * @param game  	 existing game instance
  * @param color 	 color of the set to be added
  * @return
- * MALLOC_FAILURE 	 if allocating memory failed
- * SUCCESS        	 otherwise
+ * INVALID_ARGUMENT 	 if given color has no room for the set
+ * SUCCESS          	 otherwise
  */
 EngineMessage add_game_pieces_set(Game *game, Color color);
 
@@ -317,93 +553,71 @@ int is_valid_position(int pos_x, int pos_y);
  * @param piece 	 game piece to be moved
  * @param pos_x 	 column to move the piece onto
  * @param pos_y 	 row to move the piece onto
- * @return      	 -1 on malloc failure, true iff move is legal otherwise
+ * @return      	 true iff move is legal
  */
 int is_legal_move(Game *game, GamePiece *piece, int pos_x, int pos_y);
 
 /*
- * Check if a given pawn move is legal.
- * @precond     	 assumes arguments are valid
+ * Compute checks and pins of the given side in the current position.
+ * @precond     	 game != NULL
  * @param game  	 game instance
- * @param piece 	 pawn to be moved
- * @param pos_x 	 column to move the pawn onto
- * @param pos_y 	 row to move the pawn onto
- * @return      	 true iff move is legal
+ * @param color 	 color of the side whose moves are to be filtered
+ * @param info  	 struct to be filled with checks and pins
  */
-int is_legal_pawn_move(Game *game, GamePiece *piece, int pos_x, int pos_y);
+void compute_legality_info(Game *game, Color color, LegalityInfo *info);
 
 /*
- * Check if a given rook move is legal.
- * @precond     	 assumes arguments are valid
+ * Get all positions a given piece can legally move to, by masking its pseudo legal
+ * targets with the checks and pins of its side.
  * @param game  	 game instance
- * @param piece 	 rook to be moved
- * @param pos_x 	 column to move the rook onto
- * @param pos_y 	 row to move the rook onto
- * @return      	 true iff move is legal
+ * @param piece 	 game piece
+ * @param info  	 checks and pins of the piece's side, see compute_legality_info
+ * @return      	 set of legal target positions
  */
-int is_legal_rook_move(Game *game, GamePiece *piece, int pos_x, int pos_y);
+Bitboard get_legal_targets(Game *game, GamePiece *piece, LegalityInfo *info);
 
 /*
- * Check if a given knight move is legal.
- * @precond     	 assumes arguments are valid
- * @param game  	 game instance
- * @param piece 	 knight to be moved
- * @param pos_x 	 column to move the knight onto
- * @param pos_y 	 row to move the knight onto
- * @return      	 true iff move is legal
+ * Get all positions threatened by a given piece, regardless of the color of the pieces on
+ * them. Unlike its pseudo legal targets, pawn forward moves are not included.
+ * @param piece    	 game piece
+ * @param occupied 	 set of occupied positions blocking sliding pieces
+ * @return         	 set of threatened positions
  */
-int is_legal_knight_move(GamePiece *piece, int pos_x, int pos_y);
+Bitboard get_piece_attacks(GamePiece *piece, Bitboard occupied);
 
 /*
- * Check if a given bishop move is legal.
- * @precond     	 assumes arguments are valid
+ * Get all positions a given piece can move to according to its movement rules,
+ * regardless of whether the allied king is left threatened.
  * @param game  	 game instance
- * @param piece 	 bishop to be moved
- * @param pos_x 	 column to move the bishop onto
- * @param pos_y 	 row to move the bishop onto
- * @return      	 true iff move is legal
+ * @param piece 	 game piece
+ * @return      	 set of target positions
  */
-int is_legal_bishop_move(Game *game, GamePiece *piece, int pos_x, int pos_y);
+Bitboard get_pseudo_legal_targets(Game *game, GamePiece *piece);
 
 /*
- * Check if a given queen move is legal.
- * @precond     	 assumes arguments are valid
- * @param game  	 game instance
- * @param piece 	 queen to be moved
- * @param pos_x 	 column to move the queen onto
- * @param pos_y 	 row to move the queen onto
- * @return      	 true iff move is legal
+ * Determine if game is in check state for current player.
+ * @param game 	 game instance
+ * @return     	 true iff game is in check state
  */
-int is_legal_queen_move(Game *game, GamePiece *piece, int pos_x, int pos_y);
+int is_in_check_state(Game *game);
 
 /*
- * Check if a given king move is legal.
- * @precond     	 assumes arguments are valid
+ * Determine if the king of the given color can be reached by any enemy piece.
  * @param game  	 game instance
- * @param piece 	 king to be moved
- * @param pos_x 	 column to move the king onto
- * @param pos_y 	 row to move the king onto
- * @return      	 true iff move is legal
+ * @param color 	 color of the king
+ * @return      	 true iff king is threatened
  */
-int is_legal_king_move(GamePiece *piece, int pos_x, int pos_y);
+int is_king_threatened(Game *game, Color color);
 
 /*
- * Check if given move creates a check state for the allied king of the given piece.
- * @precond     	 assumes arguments are valid
+ * Perform given move in place without updating check state. Used to try moves that are
+ * reverted right away by unmake_move.
+ * @precond     	 move is pseudo legal for the current player
  * @param game  	 game instance
- * @param piece 	 piece to be moved
- * @param pos_x 	 column to move the piece onto
- * @param pos_y 	 row to move the piece onto
- * @return      	 -1 on malloc failure, true iff move is legal otherwise
- */
-int is_check_state_created_allied(Game *game, GamePiece *piece, int pos_x, int pos_y);
-
-/*
- * Determine if game is in check state for current player.
- * @param game 	 game instance
- * @return     	 true iff game is in check state
+ * @param move  	 move to perform
+ * @param undo  	 record to be filled with the information needed by unmake_move
  */
-int is_in_check_state(Game *game);
+void move_in_place(Game *game, Move move, MoveUndo *undo);
 
 /*
  * Perform actual moving of game piece to new position.
@@ -416,92 +630,108 @@ int is_in_check_state(Game *game);
 void move_piece_to_position(Game *game, GamePiece *piece, int pos_x, int pos_y);
 
 /*
- * Find king piece in given set of pieces.
- * @precond   	 assumes arguments are valid
- * @param set 	 set of game pieces to search in
- * @return    	 pointer to king piece in given set
- */
-GamePiece *find_king_piece(SPArrayList *set);
-
-/*
- * Add given move to history.
+ * Add given move to history, packed, together with the piece it captures. The oldest entry
+ * is overwritten once the history is full.
  * @precond     	 assumes arguments are valid
  * @param src_x 	 column of source position
  * @param src_y 	 row of source position
  * @param dst_x 	 column of source position
  * @param dst_y 	 row of source position
- * @return
- * MALLOC_FAILURE 	 if failed to allocate memory for move struct
- * SUCCESS        	 otherwise
- */
-EngineMessage add_move_to_history(Game *game, int src_x, int src_y, int dst_x, int dst_y);
-
-/*
- * Create a new move struct with the given positions.
- * @param src_x 	 column of source position
- * @param src_y 	 row of source position
- * @param dst_x 	 column of source position
- * @param dst_y 	 row of source position
- * @return      	 pointer to new move struct on success, NULL otherwise
  */
-GameMove *create_move(int src_x, int src_y, int dst_x, int dst_y);
+void add_move_to_history(Game *game, int src_x, int src_y, int dst_x, int dst_y);
 
 /*
  * Get possible moves of given pawn.
  * @param game  	 game instance
  * @param piece 	 pawn instance
- * @return      	 pointer to list of possible moves on success, NULL otherwise
+ * @param info  	 checks and pins of the pawn's side
+ * @param moves 	 buffer to be filled with possible moves
+ * @return      	 number of possible moves
  */
-SPArrayList *get_pawn_moves(Game *game, GamePiece *piece);
+int get_pawn_moves(Game *game, GamePiece *piece, LegalityInfo *info, Move *moves);
 
 /*
  * Get possible moves of given rook.
  * @param game  	 game instance
  * @param piece 	 rook instance
- * @return      	 pointer to list of possible moves on success, NULL otherwise
+ * @param info  	 checks and pins of the rook's side
+ * @param moves 	 buffer to be filled with possible moves
+ * @return      	 number of possible moves
  */
-SPArrayList *get_rook_moves(Game *game, GamePiece *piece);
+int get_rook_moves(Game *game, GamePiece *piece, LegalityInfo *info, Move *moves);
 
 /*
  * Get possible moves of given knight.
  * @param game  	 game instance
  * @param piece 	 knight instance
- * @return      	 pointer to list of possible moves on success, NULL otherwise
+ * @param info  	 checks and pins of the knight's side
+ * @param moves 	 buffer to be filled with possible moves
+ * @return      	 number of possible moves
  */
-SPArrayList *get_knight_moves(Game *game, GamePiece *piece);
+int get_knight_moves(Game *game, GamePiece *piece, LegalityInfo *info, Move *moves);
 
 /*
  * Get possible moves of given bishop.
  * @param game  	 game instance
  * @param piece 	 bishop instance
- * @return      	 pointer to list of possible moves on success, NULL otherwise
+ * @param info  	 checks and pins of the bishop's side
+ * @param moves 	 buffer to be filled with possible moves
+ * @return      	 number of possible moves
  */
-SPArrayList *get_bishop_moves(Game *game, GamePiece *piece);
+int get_bishop_moves(Game *game, GamePiece *piece, LegalityInfo *info, Move *moves);
 
 /*
  * Get possible moves of given queen.
  * @param game  	 game instance
  * @param piece 	 queen instance
- * @return      	 pointer to list of possible moves on success, NULL otherwise
+ * @param info  	 checks and pins of the queen's side
+ * @param moves 	 buffer to be filled with possible moves
+ * @return      	 number of possible moves
  */
-SPArrayList *get_queen_moves(Game *game, GamePiece *piece);
+int get_queen_moves(Game *game, GamePiece *piece, LegalityInfo *info, Move *moves);
 
 /*
  * Get possible moves of given king.
  * @param game  	 game instance
  * @param piece 	 king instance
- * @return      	 pointer to list of possible moves on success, NULL otherwise
+ * @param info  	 checks and pins of the king's side
+ * @param moves 	 buffer to be filled with possible moves
+ * @return      	 number of possible moves
  */
-SPArrayList *get_king_moves(Game *game, GamePiece *piece);
+int get_king_moves(Game *game, GamePiece *piece, LegalityInfo *info, Move *moves);
 
 /*
- * Find an edge of the range of possible moves for a rook/bishop/queen.
+ * Get possible moves of given piece according to its type.
  * @param game  	 game instance
- * @param src_x 	 column of source position
- * @param src_y 	 row of source position
- * @param inc_X 	 column direction of search
- * @param inc_y 	 row direction of search
- * @return      	 offset from given position
+ * @param piece 	 game piece
+ * @param info  	 checks and pins of the piece's side
+ * @param moves 	 buffer of at least MAX_PIECE_MOVES moves to be filled with possible moves
+ * @return      	 number of possible moves
+ */
+int get_piece_moves(Game *game, GamePiece *piece, LegalityInfo *info, Move *moves);
+
+/*
+ * Add moves of given rook/bishop/queen to the given target positions, ordered by column,
+ * row, upward diagonal and downward diagonal.
+ * @param game    	 game instance
+ * @param moves   	 buffer to add moves to
+ * @param count   	 number of moves already in buffer
+ * @param piece   	 game piece to be moved
+ * @param targets 	 set of legal target positions
+ * @return        	 number of moves in buffer after adding
+ */
+int add_sliding_moves(Game *game, Move *moves, int count, GamePiece *piece, Bitboard targets);
+
+/*
+ * Add moves of given piece to each of the given target positions, in ascending (or
+ * descending) board order. Moves to positions of enemy pieces are flagged as captures.
+ * @param game       	 game instance
+ * @param moves      	 buffer to add moves to
+ * @param count      	 number of moves already in buffer
+ * @param piece      	 game piece to be moved
+ * @param targets    	 set of legal target positions
+ * @param descending 	 true to add targets from highest square to lowest
+ * @return           	 number of moves in buffer after adding
  */
-int find_range_end(Game *game, PieceType type, int src_x, int src_y, int inc_x, int inc_y);
+int add_moves_to_targets(Game *game, Move *moves, int count, GamePiece *piece, Bitboard targets, int descending);
 #endif
@@ -64,13 +64,15 @@ EngineMessage draw_chess_board(SDL_Renderer *renderer, ChessBoard *board, Game *
 	if (!game) {
 		return SUCCESS;
 	}
-	if (board->right_click == 1 && board->current_possible_moves != NULL) {
-		for (i = 0; i < spArrayListSize(board->current_possible_moves); i++) {
-			GameMove *temp = (GameMove *)spArrayListGetAt(board->current_possible_moves, i);
-			int threat = is_piece_threatened_after_move(game, game->board[temp->src_y][temp->src_x], temp);
+	if (board->right_click == 1) {
+		for (i = 0; i < board->possible_moves_count; i++) {
+			GameMove *temp = &board->current_possible_moves[i];
+			GamePiece *src_piece = get_game_piece(game, temp->src_x, temp->src_y);
+			int threat = is_piece_threatened_after_move(game, src_piece, temp);
+			GamePiece *dst_piece = get_game_piece(game, temp->dst_x, temp->dst_y);
 			if (threat == 1) {
 				current_texture = board->threat_move;
-			} else if (game->board[temp->dst_y][temp->dst_x] != NULL && game->board[temp->src_y][temp->src_x]->color != game->board[temp->dst_y][temp->dst_x]->color) {
+			} else if (dst_piece != NULL && src_piece->color != dst_piece->color) {
 				current_texture = board->eat_opponent_piece;
 			} else{
 				current_texture = board->posibble_moves;
@@ -87,12 +89,13 @@ EngineMessage draw_chess_board(SDL_Renderer *renderer, ChessBoard *board, Game *
 	}
 	for (i = 0; i < BOARD_SIZE; i++) {
 		for (j = 0; j < BOARD_SIZE; j++) {
-			if (game->board[i][j] != NULL) {
+			GamePiece *piece = get_game_piece(game, j, i);
+			if (piece != NULL) {
 				if (board->is_dragging == 1 && board->dragging_piece_row == i && board->dragging_piece_col == j) {
 					cur_i = i;
 					cur_j = j;
 				} else {
-					SDL_Texture* current_texture = board->piece_textures[game->board[i][j]->color][game->board[i][j]->type];
+					SDL_Texture* current_texture = board->piece_textures[piece->color][piece->type];
 					current_rect.x = j * width + board->board_area.x;
 					current_rect.y = (BOARD_SIZE - 1 - i) * height + board->board_area.y;
 					current_rect.w = width;
@@ -106,7 +109,8 @@ EngineMessage draw_chess_board(SDL_Renderer *renderer, ChessBoard *board, Game *
 		}
 	}
 	if (board->is_dragging == 1 && board->dragging_piece_row == cur_i && board->dragging_piece_col == cur_j){
-		SDL_Texture* current_texture = board->piece_textures[game->board[cur_i][cur_j]->color][game->board[cur_i][cur_j]->type];
+		GamePiece *piece = get_game_piece(game, cur_j, cur_i);
+		SDL_Texture* current_texture = board->piece_textures[piece->color][piece->type];
 		current_rect.x = board->board_area.x + cur_j * width + board->current_mouse_x_pos - board->start_mouse_x_pos;
 		current_rect.y = board->board_area.y + (BOARD_SIZE - 1 - cur_i) * height + board->current_mouse_y_pos - board->start_mouse_y_pos;
 		current_rect.w = width;
@@ -148,7 +152,8 @@ EngineMessage chess_board_event_handler(SDL_Event *event, ChessBoard *board , Ch
 				int row = BOARD_SIZE - 1 - ((event->button.y - board->board_area.y) * BOARD_SIZE / board->board_area.h);
 				int col = (event->button.x - board->board_area.x) * BOARD_SIZE / board->board_area.w;
 
-				if (game->board[row][col] == NULL || game->board[row][col]->color != game->player_color[game->current_player]) {
+				GamePiece *piece = get_game_piece(game, col, row);
+				if (piece == NULL || piece->color != game->player_color[game->current_player]) {
 					break;
 				}
 				if (is_game_over(game)) {
@@ -165,7 +170,7 @@ EngineMessage chess_board_event_handler(SDL_Event *event, ChessBoard *board , Ch
 					board->current_mouse_y_pos = event->button.y;
 				} else if (event->button.button == SDL_BUTTON_RIGHT && !(game->mode == ONE_PLAYER && game->difficulty > 2)) {
 					board->right_click = 1;
-					EngineMessage msg = get_possible_moves(&board->current_possible_moves, game, game->board[row][col]);
+					EngineMessage msg = get_possible_moves(board->current_possible_moves, &board->possible_moves_count, game, piece);
 					if (msg != SUCCESS) {
 						return msg;
 					}
@@ -175,7 +180,7 @@ EngineMessage chess_board_event_handler(SDL_Event *event, ChessBoard *board , Ch
 		case SDL_MOUSEBUTTONUP:
 			if (board->right_click == 1) {
 				board->right_click = 0;
-				spArrayListDestroy(board->current_possible_moves);
+				board->possible_moves_count = 0;
 			}
 			if (board->is_dragging) {
 				board->is_dragging = 0;
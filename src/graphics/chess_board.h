@@ -40,7 +40,8 @@ typedef struct {
     int right_click;
     SDL_Texture* threat_move;
     SDL_Texture* eat_opponent_piece;
-    SPArrayList *current_possible_moves;
+    GameMove current_possible_moves[MAX_PIECE_MOVES];
+    int possible_moves_count;
 } ChessBoard;
 
 typedef struct {
@@ -180,7 +180,9 @@ EngineMessage start_new_game(GameSettings *settings, GameScreen *game_screen) {
 	game_screen->is_game_over = 0;
 
 	if (game_screen->game->mode == ONE_PLAYER && game_screen->game->current_player == PLAYER2) {
-		msg = minimax_suggest_move(game_screen->game, game_screen->game->difficulty, &comp_move);
+		SearchOptions options;
+		init_search_options(&options, game_screen->game->difficulty);
+		msg = minimax_suggest_move(game_screen->game, &options, &comp_move, NULL);
 		if (msg != SUCCESS) {
 			return msg;
 		}
@@ -196,10 +198,13 @@ EngineMessage start_new_game(GameSettings *settings, GameScreen *game_screen) {
 }
 
 EngineMessage start_load_game(int slot_num, GameScreen *game_screen) {
-	game_screen->game = load_saved_game(slot_num);
-	if (game_screen->game == NULL) {
+	Game *game = load_saved_game(slot_num);
+	if (game == NULL) {
 		return LOAD_ERROR;
 	}
+	/* Previous game and the results of its searches are discarded */
+	destroy_game(game_screen->game);
+	game_screen->game = game;
 	game_screen->moves_since_save = 0;
 	game_screen->is_game_over = is_game_over(game_screen->game);
 	return SUCCESS;
@@ -213,7 +218,7 @@ int should_draw_undo_button(GameScreen* game_screen) {
 		return 0;
 	}
 
-	int undo_history_size = spArrayListSize(game_screen->game->move_history);
+	int undo_history_size = game_screen->game->history_count;
 	if (undo_history_size == 0) {
 		return 0;
 	}
@@ -341,7 +346,7 @@ EngineMessage save_game_message_box(GameScreen *game_screen, GameScreenEvent *ga
 
 EngineMessage game_screen_event_handler(SDL_Event *event, GameScreen *game_screen, GameScreenEvent *game_screen_event) {
 	EngineMessage msg = SUCCESS;
-	GameMove *move;
+	GameMove move;
 	ChessBoardEvent chess_board_event;
 	ButtonEvent button_event;
 
@@ -439,7 +444,6 @@ EngineMessage game_screen_event_handler(SDL_Event *event, GameScreen *game_scree
 			if (msg != SUCCESS) {
 				return msg;
 			}
-			free(move);
 			game_screen->moves_since_save--;
 			game_screen->is_game_over = 0;
 
@@ -448,13 +452,12 @@ EngineMessage game_screen_event_handler(SDL_Event *event, GameScreen *game_scree
 				if (msg != SUCCESS) {
 					return msg;
 				}
-				free(move);
 				game_screen->moves_since_save--;
 			}
 
 			if (game_screen->moves_since_save < 0) {
 				// Saving should be possible now if we continue undoing, and if we do new moves.
-				game_screen->moves_since_save = spArrayListSize(game_screen->game->move_history) + 1;
+				game_screen->moves_since_save = game_screen->game->history_count + 1;
 			}
 		}
 	}
@@ -462,7 +465,9 @@ EngineMessage game_screen_event_handler(SDL_Event *event, GameScreen *game_scree
 	if (game_screen->game && !game_screen->is_game_over && game_screen->game->mode == ONE_PLAYER && game_screen->game->current_player == PLAYER2) {
 		/* Initialize comp_move so we can know if it was assigned a value yet */
 		GameMove comp_move = {-1, -1, -1, -1};
-		msg = minimax_suggest_move(game_screen->game, game_screen->game->difficulty, &comp_move);
+		SearchOptions options;
+		init_search_options(&options, game_screen->game->difficulty);
+		msg = minimax_suggest_move(game_screen->game, &options, &comp_move, NULL);
 		if (msg != SUCCESS) {
 			return msg;
 		}
@@ -5,14 +5,17 @@
 #include <SDL_video.h>
 
 #include "main_aux.h"
+#include "perft.h"
+#include "bench.h"
 #include "graphics/window.h"
 
-int cli_main() {
+int cli_main(int report_stats) {
 	ProgramState *prog_state;
 	if(!(prog_state = create_program_state())){
 		print_generic_message(MALLOC_FAILURE);
 		return 0;
 	}
+	prog_state->indicators->report_stats = report_stats;
 	do {
 		if(prog_state->indicators->run_state == GAME){
 			if(!(fetch_and_exe_game(prog_state))){
@@ -73,19 +76,76 @@ EngineMessage gui_main() {
 }
 
 int main(int argc, char *argv[]) {
-	if (argc == 1) {
-		return cli_main();
-	};
-
-	if (argc == 2) {
-		if (!strcmp(argv[1], "-c")) {
-			return cli_main();
+	int gui = 0;
+	int report_stats = 0;
+	int perft_depth = 0;
+	char *perft_file = NULL;
+	int bench_depth = 0;
+	char **bench_files = NULL;
+	int bench_count = 0;
+	SearchOptions options = {.threads = 1};
+	for (int i = 1; i < argc; i++) {
+		if (!strcmp(argv[i], "-c")) {
+			gui = 0;
+		} else if (!strcmp(argv[i], "-g")) {
+			gui = 1;
+		} else if (!strcmp(argv[i], "-hash") && i + 1 < argc && atoi(argv[i + 1]) > 0) {
+			set_hash_size(atoi(argv[++i]));
+		} else if (!strcmp(argv[i], "-time") && i + 1 < argc && atol(argv[i + 1]) > 0) {
+			options.time_limit_ms = atol(argv[++i]);
+		} else if (!strcmp(argv[i], "-nodes") && i + 1 < argc && atol(argv[i + 1]) > 0) {
+			options.node_limit = atol(argv[++i]);
+		} else if (!strcmp(argv[i], "-threads") && i + 1 < argc
+				&& atoi(argv[i + 1]) > 0 && atoi(argv[i + 1]) <= MAX_SEARCH_THREADS) {
+			options.threads = atoi(argv[++i]);
+		} else if (!strcmp(argv[i], "-root-split")) {
+			options.root_split = 1;
+		} else if (!strcmp(argv[i], "-quiescence")) {
+			options.quiescence = 1;
+		} else if (!strcmp(argv[i], "-pvs")) {
+			options.pvs = 1;
+		} else if (!strcmp(argv[i], "-aspiration") && i + 1 < argc && atoi(argv[i + 1]) > 0) {
+			options.aspiration_window = atoi(argv[++i]);
+		} else if (!strcmp(argv[i], "-seed") && i + 1 < argc) {
+			set_shuffle_seed(strtoul(argv[++i], NULL, 10));
+		} else if (!strcmp(argv[i], "-stats")) {
+			report_stats = 1;
+		} else if (!strcmp(argv[i], "-perft") && i + 2 < argc && atoi(argv[i + 1]) > 0) {
+			perft_depth = atoi(argv[++i]);
+			perft_file = argv[++i];
+		} else if (!strcmp(argv[i], "-bench") && i + 2 < argc && atoi(argv[i + 1]) > 0) {
+			/* Remaining arguments are the positions to search */
+			bench_depth = atoi(argv[++i]);
+			bench_files = &argv[i + 1];
+			bench_count = argc - i - 1;
+			break;
+		} else {
+			printf("USAGE: %s <-c/-g> [-hash <MB>] [-time <ms>] [-nodes <count>]"
+					" [-threads <count>] [-root-split] [-quiescence] [-pvs]"
+					" [-aspiration <width>] [-seed <number>] [-stats]"
+					" [-perft <depth> <file>] [-bench <depth> <files>...]\n", argv[0]);
+			return 1;
 		}
-		if (!strcmp(argv[1], "-g")) {
-			return gui_main();
+	}
+	if (perft_file) {
+		if (run_perft(perft_file, perft_depth) != SUCCESS) {
+			printf("Error: File doesn't exist or cannot be opened\n");
+			return 1;
 		}
+		return 0;
 	}
-
-	printf("USAGE: %s <-c/-g>\n", argv[0]);
-	return 1;
+	set_default_search_options(&options);
+	if (bench_files) {
+		EngineMessage msg = run_bench(bench_files, bench_count, bench_depth);
+		if (msg == LOAD_ERROR) {
+			printf("Error: File doesn't exist or cannot be opened\n");
+		} else if (msg == MALLOC_FAILURE) {
+			print_generic_message(msg);
+		}
+		return msg != SUCCESS;
+	}
+	if (gui) {
+		return gui_main();
+	}
+	return cli_main(report_stats);
 }
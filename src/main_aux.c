@@ -22,6 +22,7 @@ int init_program_state(ProgramState *prog_state){
 	prog_state->user_input = (char *)malloc(INPUT_SIZE);
 	prog_state->settings = create_settings();
 	prog_state->indicators = create_indicators();
+	prog_state->game = NULL;
 	if(!prog_state->user_input || !prog_state->settings || !prog_state->indicators){
 		free(prog_state->user_input);
 		free(prog_state->settings);
@@ -38,6 +39,7 @@ Indicators *create_indicators(){
 	indicators->print_game_prompt = 1;
 	indicators->print_settings_prompt = 1;
 	indicators->game_loaded = 0;
+	indicators->report_stats = 0;
 	indicators->run_state = SETTINGS;
 	return indicators;
 }
@@ -61,7 +63,10 @@ int fetch_and_exe_game(ProgramState *state){
 int fetch_and_exe_ai(ProgramState *state){
 	/* Initialize move to these values so we can know if it wasn't assigned a real value yet */
 	GameMove computer_move = {-1, -1, -1 ,-1};
-	EngineMessage msg = minimax_suggest_move(state->game, state->game->difficulty, &computer_move);
+	SearchOptions options;
+	SearchStats stats;
+	init_search_options(&options, state->game->difficulty);
+	EngineMessage msg = minimax_suggest_move(state->game, &options, &computer_move, &stats);
 	if (msg != SUCCESS) {
 		handle_message(state, msg);
 		return 0;
@@ -71,7 +76,10 @@ int fetch_and_exe_ai(ProgramState *state){
 		handle_message(state, msg);
 		return 0;
 	}
-	print_computer_move(state->game->board[computer_move.dst_y][computer_move.dst_x]->type, &computer_move);
+	print_computer_move(get_game_piece(state->game, computer_move.dst_x, computer_move.dst_y)->type, &computer_move);
+	if (state->indicators->report_stats) {
+		print_search_stats(&stats);
+	}
 	if (msg == GAME_OVER) {
 		handle_message(state, msg);
 		return 1;
@@ -145,26 +153,23 @@ EngineMessage execute_game_command(Game *game, GameCommand *cmd){
 					return INVALID_COMMAND;
 				if(!cmd->valid_arg)
 					return INVALID_ARGUMENT;
-				SPArrayList *moves;
+				GameMove moves[MAX_PIECE_MOVES];
+				int count;
 				EngineMessage msg = get_possible_moves(
-						&moves, game,
-						game->board[args[1]][args[0]]);
-				if(msg == SUCCESS) print_possible_moves(game, moves);
-				spArrayListDestroy(moves);
+						moves, &count, game,
+						get_game_piece(game, args[0], args[1]));
+				if(msg == SUCCESS) print_possible_moves(game, moves, count);
 				if(msg == SUCCESS) return SUCCESS_NO_PRINT;
 				return msg;
 			}
 		case UNDO:
 			{
 				if(game->mode != ONE_PLAYER) return INVALID_COMMAND;
-				GameMove *moves[2];
+				GameMove moves[2];
 				EngineMessage msg = undo_move(game, &moves[0]);
 				if(msg != SUCCESS) return msg;
 				msg = undo_move(game, &moves[1]);
-				if(msg != SUCCESS){
-					free(moves[0]);
-					return msg;
-				}
+				if(msg != SUCCESS) return msg;
 				print_undo_two_moves(game, moves);
 				return SUCCESS;
 			}
@@ -258,6 +263,7 @@ void handle_settings_message(ProgramState *state, EngineMessage msg, SettingComm
 		print_settings_error(cmd);
 	} else if (msg == GAME_LOAD) {
 		FILE *in = (FILE *)cmd->arg;
+		destroy_game(state->game); /* game loaded earlier, if any */
 		state->game = load_game(in);
 		if(state->game){
 			/* Update settings struct with loaded game settings */
@@ -291,10 +297,11 @@ void handle_message(ProgramState *state, EngineMessage msg){
 				state->game = create_game(state->settings);
 			} else {
 				if(state->game){
+					/* Searches of a game played before a reset don't apply to this one */
+					clear_search_results(state->game);
 					/* Update loaded game with new settings */
 					state->game->difficulty = state->settings->difficulty;
-					state->game->player_color[PLAYER1] = state->settings->player1_color;
-					state->game->player_color[PLAYER2] = !state->settings->player1_color;
+					set_player_colors(state->game, state->settings->player1_color);
 					state->game->mode = state->settings->mode;
 				}
 			}
@@ -305,6 +312,11 @@ void handle_message(ProgramState *state, EngineMessage msg){
 			}
 			return;
 		case RESTART:
+			/* A game that wasn't loaded is replaced by a new one, along with its table */
+			if(!state->indicators->game_loaded){
+				destroy_game(state->game);
+				state->game = NULL;
+			}
 			state->settings = create_settings();
 			if(!state->settings){
 				print_generic_message(MALLOC_FAILURE);
@@ -27,6 +27,7 @@ typedef struct {
 	int print_settings_prompt;
 	int print_game_prompt;
 	int game_loaded;
+	int report_stats; /* print search statistics after each computer move */
 	RunState run_state;
 } Indicators;
 
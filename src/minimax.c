@@ -1,32 +1,86 @@
 #include <limits.h>
+#include <pthread.h>
 #include <stdlib.h>
 
 #include "minimax.h"
+#include "transposition_table.h"
+#include "move_ordering.h"
+#include "arena.h"
+#include "timer.h"
 
-int color_score(Game* game, Color color) {
-	int value = 0;
-	SPArrayList *pieces = (color == WHITE) ? game->white_pieces : game->black_pieces;
-	for(int i = 0; i < spArrayListSize(pieces); i++) {
-		GamePiece* piece = (GamePiece*)spArrayListGetAt(pieces, i);
-		if (piece->type == PAWN) {
-			value += 1;
-		} else if (piece->type == KNIGHT || piece->type == BISHOP) {
-			value += 3;
-		} else if (piece->type == ROOK) {
-			value += 5;
-		} else if (piece->type == QUEEN) {
-			value += 9;
-		} else if (piece->type == KING) {
-			value += 100;
-		}
-	}
-	return value;
+/* Number of nodes between checks of the clock, minus one */
+#define TIME_CHECK_INTERVAL 1023
+/* Most positional gain a capture may add to the value of the captured piece */
+#define DELTA_MARGIN 2
+
+/* State shared by all nodes of a single search */
+typedef struct {
+	SearchOptions *options;
+	int depth; /* depth of current iteration */
+	SearchStats stats; /* counters of the search so far */
+	long long deadline_us; /* time the search must stop at, if it has a time limit */
+	int stopped; /* set once a limit has been reached */
+	int *abort_search; /* flag set by the main thread to stop helper threads, NULL for itself */
+	OrderingTables ordering; /* killers and history, kept between iterations */
+	Arena *arena; /* memory of threads and game copies, NULL for helper threads */
+} SearchContext;
+
+/* State of a helper thread of a parallel search */
+typedef struct {
+	pthread_t thread;
+	Game *game; /* private copy of the searched game, sharing its transposition table */
+	SearchOptions options; /* options of the search, without limits */
+	SearchContext context;
+	int depth_offset; /* number of plies the helper searches ahead of the main thread */
+} SearchHelper;
+
+struct RootSplit;
+
+/* Root moves waiting to be searched by a worker of a root split search. The owner takes moves
+ * from the front, idle workers steal moves from the back */
+typedef struct {
+	int items[MAX_MOVES]; /* positions of moves in the search order of the root */
+	int head, tail;
+	pthread_mutex_t lock;
+} WorkQueue;
+
+/* State of a worker of a root split search */
+typedef struct {
+	pthread_t thread;
+	Game *game; /* searched game for the first worker, a private copy of it for the others */
+	SearchOptions options; /* options of the search, with a share of its node limit */
+	SearchContext context;
+	WorkQueue queue;
+	EngineMessage msg; /* result of the last subtree searched */
+	struct RootSplit *split;
+} SplitWorker;
+
+/* State of a single iteration of a root split search, shared by all of its workers */
+typedef struct RootSplit {
+	Move moves[MAX_MOVES]; /* root moves in search order */
+	int indices[MAX_MOVES]; /* generation order of each move */
+	int move_scores[MAX_MOVES]; /* score of each move */
+	int exact[MAX_MOVES]; /* true iff score of the move is exact, otherwise it is worse than the best */
+	int count;
+	Color color; /* color of the player to move */
+	int best_score; /* best exact score found so far, updated atomically */
+	SplitWorker *workers;
+	int worker_count;
+} RootSplit;
+
+static size_t hash_size_mb = DEFAULT_HASH_SIZE_MB;
+static SearchOptions default_options = {.threads = 1};
+
+void set_hash_size(size_t megabytes){
+	hash_size_mb = megabytes;
+}
+
+size_t get_hash_size(){
+	return hash_size_mb;
 }
 
 int score(Game* game) {
-	int white = color_score(game, WHITE);
-	int black = color_score(game, BLACK);
-	return white - black;
+	return game->material[WHITE] - game->material[BLACK];
 }
 
 int game_over_score(Game *game){
@@ -38,73 +92,648 @@ int game_over_score(Game *game){
 }
 
 EngineMessage handle_edge_case(Game *game, int game_over, int *node_score){
-	if (game_over == -1) return MALLOC_FAILURE;
 	if(node_score) *node_score = game_over ? game_over_score(game) : score(game);
 	return SUCCESS;
 }
 
-EngineMessage quit_error(Game *game, SPArrayList *moves){
-	destroy_game(game);
-	spArrayListDestroy(moves);
-	return MALLOC_FAILURE;
+int should_stop(SearchContext *context){
+	if (context->stopped) return 1;
+	if (context->abort_search && __atomic_load_n(context->abort_search, __ATOMIC_RELAXED)) {
+		context->stopped = 1;
+		return 1;
+	}
+	/* Always complete the first iteration, so there is a move to suggest */
+	if (context->depth <= 1) return 0;
+	SearchOptions *options = context->options;
+	long nodes = context->stats.nodes + context->stats.qnodes;
+	if (options->node_limit && nodes >= options->node_limit) {
+		context->stopped = 1;
+	} else if (options->time_limit_ms && (nodes & TIME_CHECK_INTERVAL) == 0
+			&& current_time_us() >= context->deadline_us) {
+		context->stopped = 1;
+	}
+	/* Threads searching parts of the same iteration stop together */
+	if (context->stopped && context->abort_search) {
+		__atomic_store_n(context->abort_search, 1, __ATOMIC_RELAXED);
+	}
+	return context->stopped;
+}
+
+void count_cutoff(SearchContext *context, int move_index) {
+	context->stats.cutoffs++;
+	if (move_index == 0) context->stats.first_move_cutoffs++;
+}
+
+EngineMessage quiescence_node(Game* game, SearchContext *context, int ply, int alpha, int beta, int *node_score) {
+	EngineMessage msg = SUCCESS;
+	Color current_player_color = game->player_color[game->current_player];
+
+	if (should_stop(context)) return SUCCESS;
+	context->stats.qnodes++;
+	if (ply > context->stats.max_depth) context->stats.max_depth = ply;
+
+	Move moves[MAX_MOVES];
+	int count = get_all_possible_moves(game, moves);
+	if (count == 0){
+		return handle_edge_case(game, 1, node_score);
+	}
+
+	/* Player may stand pat on the static score instead of capturing, unless in check where
+	 * all moves are searched */
+	int stand_pat = score(game);
+	if (!game->check) {
+		if (current_player_color == WHITE) {
+			if (stand_pat > alpha) alpha = stand_pat;
+		} else {
+			if (stand_pat < beta) beta = stand_pat;
+		}
+		if (alpha >= beta) {
+			*node_score = stand_pat;
+			return SUCCESS;
+		}
+
+		/* Keep captures only */
+		int captures = 0;
+		for (int i = 0; i < count; i++) {
+			if (moves[i] & MOVE_CAPTURE) moves[captures++] = moves[i];
+		}
+		count = captures;
+	}
+
+	int scores[MAX_MOVES];
+	score_moves(game, moves, count, MOVE_NONE, &context->ordering, MAX_PLY, scores);
+
+	int son_score;
+	for (int i = 0; i < count; i++) {
+		pick_next_move(moves, scores, NULL, count, i);
+		Move move = moves[i];
+
+		/* Skip captures that can't bring the score back into the window (delta pruning) */
+		if (!game->check && (move & MOVE_CAPTURE)) {
+			GamePiece *victim = get_game_piece(game, SQUARE_X(MOVE_DST(move)), SQUARE_Y(MOVE_DST(move)));
+			int gain = piece_values[victim->type] + DELTA_MARGIN;
+			if (current_player_color == WHITE && stand_pat + gain <= alpha) continue;
+			if (current_player_color == BLACK && stand_pat - gain >= beta) continue;
+		}
+
+		MoveUndo undo;
+		make_move(game, move, &undo);
+		msg = quiescence_node(game, context, ply+1, alpha, beta, &son_score);
+		unmake_move(game, &undo);
+		if (msg != SUCCESS || context->stopped) return msg;
+
+		if (current_player_color == WHITE && son_score > alpha) alpha = son_score;
+		if (current_player_color == BLACK && son_score < beta) beta = son_score;
+		if (alpha >= beta) {
+			count_cutoff(context, i);
+			break;
+		}
+	}
+
+	*node_score = (current_player_color == WHITE) ? alpha : beta;
+	return SUCCESS;
+}
+
+EngineMessage minimax_node(Game* game, SearchContext *context, int max_depth, int alpha, int beta, int *node_score);
+
+/*
+ * Search a child of a node whose player has the given color with the given window. With PVS,
+ * a move other than the first one is expected to be worse than the best so far, so it is only
+ * tested against the bound of that player with a null window, and searched with the whole
+ * window again if the test shows it is better.
+ */
+EngineMessage search_child(Game *game, SearchContext *context, Color color, int max_depth,
+		int alpha, int beta, int first, int *son_score) {
+	if (context->options->pvs && !first && alpha + 1 < beta) {
+		int bound = (color == WHITE) ? alpha : beta - 1;
+		EngineMessage msg = minimax_node(game, context, max_depth, bound, bound + 1, son_score);
+		if (msg != SUCCESS || context->stopped) return msg;
+		if ((color == WHITE) ? *son_score <= alpha : *son_score >= beta) return SUCCESS;
+	}
+	return minimax_node(game, context, max_depth, alpha, beta, son_score);
 }
 
-EngineMessage minimax_node(Game* game, int max_depth, int alpha, int beta, GameMove *suggested_move, int *node_score) {
+EngineMessage minimax_node(Game* game, SearchContext *context, int max_depth, int alpha, int beta, int *node_score) {
 	EngineMessage msg = SUCCESS;
 	Color current_player_color = game->player_color[game->current_player];
 
-	int game_over = is_game_over(game);
-	if (game_over || max_depth == 0){
-		return handle_edge_case(game, game_over, node_score);
+	int ply = context->depth - max_depth;
+	if (max_depth == 0 && context->options->quiescence) {
+		return quiescence_node(game, context, ply, alpha, beta, node_score);
 	}
 
+	/* Score of a stopped search is never used */
+	if (should_stop(context)) return SUCCESS;
+	context->stats.nodes++;
+	if (ply > context->stats.max_depth) context->stats.max_depth = ply;
+
+	if (max_depth == 0){
+		return handle_edge_case(game, is_game_over(game), node_score);
+	}
+
+	/* Reuse result of an earlier search of this position to the same depth. Deeper results
+	 * are not used, so that the suggested move doesn't depend on the contents of the table */
+	ZobristKey key = game->hash;
+	TTEntry entry;
+	int found = tt_probe(game->tt, key, &entry);
+	context->stats.tt_probes++;
+	if (found) context->stats.tt_hits++;
+	if (found && entry.depth == max_depth) {
+		if (entry.bound == BOUND_EXACT
+				|| (entry.bound == BOUND_LOWER && entry.score >= beta)
+				|| (entry.bound == BOUND_UPPER && entry.score <= alpha)) {
+			if (node_score) *node_score = entry.score;
+			return SUCCESS;
+		}
+	}
+	int alpha_orig = alpha, beta_orig = beta;
+	Move best_move = MOVE_NONE;
+
+	/* Generate all moves of this node into a stack buffer, no moves left means game over */
+	Move moves[MAX_MOVES];
+	int count = get_all_possible_moves(game, moves);
+	if (count == 0){
+		handle_edge_case(game, 1, node_score);
+		tt_store(game->tt, key, max_depth, BOUND_EXACT, game_over_score(game), MOVE_NONE);
+		return SUCCESS;
+	}
+
+	/* Rank moves so that likely cutoffs are searched first */
+	int scores[MAX_MOVES];
+	score_moves(game, moves, count, found ? entry.best_move : MOVE_NONE, &context->ordering, ply, scores);
+
 	int son_score;
-	SPArrayList *pieces = (current_player_color == WHITE) ? game->white_pieces : game->black_pieces;
+	for (int i = 0; i < count; i++) {
+		pick_next_move(moves, scores, NULL, count, i);
+		Move move = moves[i];
 
-	for (int i = 0; i < spArrayListSize(pieces); i++) {
-		GamePiece *piece = (GamePiece *)spArrayListGetAt(pieces, i);
-		SPArrayList *moves;
-		if ((msg = get_possible_moves(&moves, game, piece)) != SUCCESS) return msg;
+		/* Search the move in place and revert it before trying the next one */
+		MoveUndo undo;
+		make_move(game, move, &undo);
+		msg = search_child(game, context, current_player_color, max_depth-1, alpha, beta, i == 0, &son_score);
+		unmake_move(game, &undo);
+		if (msg != SUCCESS || context->stopped) return msg;
 
-		for (int j = 0; j < spArrayListSize(moves); j++) {
-			GameMove *move = (GameMove *)spArrayListGetAt(moves, j);
-			/* Make sure suggested_move is initialized */
-			if (max_depth == game->difficulty && suggested_move && suggested_move->src_x == -1)
-				*suggested_move = *move;
+		if (current_player_color == WHITE && son_score > alpha) {
+			alpha = son_score;
+			best_move = move;
+		}
+		if (current_player_color == BLACK && son_score < beta) {
+			beta = son_score;
+			best_move = move;
+		}
+
+		if (alpha >= beta) {
+			count_cutoff(context, i);
+			if (!(move & MOVE_CAPTURE)) {
+				update_ordering_tables(&context->ordering, current_player_color, move, ply, max_depth);
+			}
+			break;
+		}
+	}
+
+	/* A score at or beyond either end of the window only bounds the value of the position */
+	int result = (current_player_color == WHITE) ? alpha : beta;
+	BoundType bound = BOUND_EXACT;
+	if (result <= alpha_orig) bound = BOUND_UPPER;
+	else if (result >= beta_orig) bound = BOUND_LOWER;
+	tt_store(game->tt, key, max_depth, bound, result, best_move);
+
+	if (node_score) *node_score = result;
+	return SUCCESS;
+}
 
-			Game *copy = copy_game(game);
-			if (!copy) return quit_error(NULL, moves);
+EngineMessage minimax_root(Game *game, SearchContext *context, int max_depth, int alpha, int beta,
+		Move *suggested_move, int *root_score, BoundType *bound) {
+	EngineMessage msg = SUCCESS;
+	Color current_player_color = game->player_color[game->current_player];
+	context->stats.nodes++;
 
-			msg = move_game_piece(copy, piece->pos_x, piece->pos_y, move->dst_x, move->dst_y);
-			if (msg != SUCCESS && msg != GAME_OVER) return quit_error(copy, moves);
+	Move moves[MAX_MOVES];
+	int count = get_all_possible_moves(game, moves);
+	if (count == 0) {
+		/* Game is over, there is no move to suggest */
+		*root_score = game_over_score(game);
+		*bound = BOUND_EXACT;
+		return SUCCESS;
+	}
 
-			if ((msg = minimax_node(copy, max_depth-1, alpha, beta, NULL, &son_score)) != SUCCESS)
-				return quit_error(copy, moves);
+	/* Remember generation order of each move, which breaks ties between equal scores */
+	int indices[MAX_MOVES];
+	for (int i = 0; i < count; i++) indices[i] = i;
+	int scores[MAX_MOVES];
+	TTEntry entry;
+	int found = tt_probe(game->tt, game->hash, &entry);
+	context->stats.tt_probes++;
+	if (found) context->stats.tt_hits++;
+	score_moves(game, moves, count, found ? entry.best_move : MOVE_NONE, &context->ordering, 0, scores);
 
-			if (current_player_color == WHITE && son_score > alpha) {
-				alpha = son_score;
-				if (max_depth == game->difficulty) {
-					*suggested_move = *move;
-				}
+	/* Suggest the best move, and the first generated one among equally good moves. A move
+	 * generated before the current best one is searched with a window one point wider, so
+	 * that it is chosen when its score is equal as well. Until a move is found, the end of
+	 * the root window of the current player stands in for the best score, so a move scoring
+	 * equal to it is scored exactly */
+	int best_score = (current_player_color == WHITE) ? alpha : beta;
+	int best_index = count;
+	int son_score;
+	*bound = BOUND_EXACT;
+	for (int i = 0; i < count; i++) {
+		pick_next_move(moves, scores, indices, count, i);
+		Move move = moves[i];
+		int tie_wins = indices[i] < best_index;
+		/* Nothing beats a winning score, and searching with an empty window gives no bound */
+		if (!tie_wins && best_score == ((current_player_color == WHITE) ? INT_MAX : INT_MIN)) continue;
+
+		MoveUndo undo;
+		make_move(game, move, &undo);
+		if (current_player_color == WHITE) {
+			int son_alpha = (tie_wins && best_score != INT_MIN) ? best_score - 1 : best_score;
+			msg = search_child(game, context, WHITE, max_depth-1, son_alpha, beta, i == 0, &son_score);
+			unmake_move(game, &undo);
+			if (msg != SUCCESS || context->stopped) return msg;
+			if (son_score > son_alpha || (tie_wins && best_score == INT_MIN)) {
+				best_score = son_score;
+				best_index = indices[i];
+				*suggested_move = move;
+			}
+			/* The root is worth at least the end of its window, its exact score is unknown */
+			if (beta != INT_MAX && son_score >= beta) {
+				*bound = BOUND_LOWER;
+				break;
 			}
-			if (current_player_color == BLACK && son_score < beta) {
-				beta = son_score;
-				if (max_depth == game->difficulty) {
-					*suggested_move = *move;
-				}
+		} else {
+			int son_beta = (tie_wins && best_score != INT_MAX) ? best_score + 1 : best_score;
+			msg = search_child(game, context, BLACK, max_depth-1, alpha, son_beta, i == 0, &son_score);
+			unmake_move(game, &undo);
+			if (msg != SUCCESS || context->stopped) return msg;
+			if (son_score < son_beta || (tie_wins && best_score == INT_MAX)) {
+				best_score = son_score;
+				best_index = indices[i];
+				*suggested_move = move;
 			}
+			if (alpha != INT_MIN && son_score <= alpha) {
+				*bound = BOUND_UPPER;
+				break;
+			}
+		}
+	}
+	/* No move reaching the end of the window of the current player bounds the root by it */
+	if (best_index == count) *bound = (current_player_color == WHITE) ? BOUND_UPPER : BOUND_LOWER;
+	*root_score = best_score;
+
+	/* Root searched within its window has an exact score. Its best move is searched first by
+	 * the next iteration */
+	if (*bound == BOUND_EXACT) {
+		tt_store(game->tt, game->hash, max_depth, BOUND_EXACT, best_score, *suggested_move);
+	}
+	return SUCCESS;
+}
 
-			destroy_game(copy);
-			if (alpha >= beta) break;
+/*
+ * Search a single iteration with minimax_root. With aspiration windows, the root is first
+ * searched with a window around the score of the previous iteration, which is widened on the
+ * side the score falls outside of until the score is exact.
+ */
+EngineMessage search_iteration(Game *game, SearchContext *context, int prev_score,
+		Move *suggested_move, int *root_score) {
+	long long width = context->options->aspiration_window;
+	int alpha = INT_MIN, beta = INT_MAX;
+	if (width && context->depth > 1 && prev_score != INT_MIN && prev_score != INT_MAX) {
+		alpha = (prev_score - width > INT_MIN) ? (int)(prev_score - width) : INT_MIN;
+		beta = (prev_score + width < INT_MAX) ? (int)(prev_score + width) : INT_MAX;
+	}
+	for (;;) {
+		BoundType bound;
+		EngineMessage msg = minimax_root(game, context, context->depth, alpha, beta, suggested_move,
+				root_score, &bound);
+		if (msg != SUCCESS || context->stopped || bound == BOUND_EXACT) return msg;
+		*suggested_move = MOVE_NONE;
+		width *= 2;
+		if (bound == BOUND_UPPER) {
+			alpha = (*root_score - width > INT_MIN) ? (int)(*root_score - width) : INT_MIN;
+		} else {
+			beta = (*root_score + width < INT_MAX) ? (int)(*root_score + width) : INT_MAX;
 		}
-		spArrayListDestroy(moves);
-		if (alpha >= beta) break;
 	}
+}
+
+void init_search_context(SearchContext *context, SearchOptions *options, int *abort_search) {
+	context->options = options;
+	context->stats = (SearchStats){0};
+	context->stopped = 0;
+	context->abort_search = abort_search;
+	context->arena = NULL;
+	clear_ordering_tables(&context->ordering);
+}
+
+/*
+ * Add the counters of a thread's search to the statistics of the whole search.
+ */
+void add_search_stats(SearchStats *stats, SearchStats *thread_stats) {
+	stats->nodes += thread_stats->nodes;
+	stats->qnodes += thread_stats->qnodes;
+	stats->cutoffs += thread_stats->cutoffs;
+	stats->first_move_cutoffs += thread_stats->first_move_cutoffs;
+	stats->tt_probes += thread_stats->tt_probes;
+	stats->tt_hits += thread_stats->tt_hits;
+	if (thread_stats->max_depth > stats->max_depth) stats->max_depth = thread_stats->max_depth;
+}
+
+void *helper_search(void *arg) {
+	SearchHelper *helper = arg;
+	SearchContext *context = &helper->context;
+	/* Iterate like the main thread, but some plies ahead of it, so that the main thread finds
+	 * the results of its next iteration in the shared table. Its moves are discarded */
+	int max_depth = (int)helper->options.max_depth;
+	int score = 0;
+	for (context->depth = 1 + helper->depth_offset; context->depth <= max_depth; context->depth++) {
+		Move move;
+		if (search_iteration(helper->game, context, score, &move, &score) != SUCCESS) break;
+		if (context->stopped) break;
+	}
+	return NULL;
+}
+
+/*
+ * Start helper threads searching copies of the given game, returning the number of threads
+ * started. Copies are allocated from the given arena and share the table of the game. Fewer
+ * helpers are started if a copy or a thread can't be created.
+ */
+int start_helpers(Game *game, SearchOptions *options, SearchHelper *helpers, int count,
+		int *abort_search, Arena *arena) {
+	int started = 0;
+	for (int i = 0; i < count; i++) {
+		SearchHelper *helper = &helpers[started];
+		if (!(helper->game = arena_alloc(arena, sizeof(Game)))) break;
+		*helper->game = *game;
+		helper->options = *options;
+		helper->options.time_limit_ms = 0;
+		helper->options.node_limit = 0;
+		helper->depth_offset = (i % 2) + 1;
+		init_search_context(&helper->context, &helper->options, abort_search);
+		if (pthread_create(&helper->thread, NULL, helper_search, helper)) break;
+		started++;
+	}
+	return started;
+}
+
+/*
+ * Stop and join the given helper threads, adding their statistics to the given ones.
+ */
+void stop_helpers(SearchHelper *helpers, int count, int *abort_search, SearchStats *stats) {
+	__atomic_store_n(abort_search, 1, __ATOMIC_RELAXED);
+	for (int i = 0; i < count; i++) {
+		pthread_join(helpers[i].thread, NULL);
+		add_search_stats(stats, &helpers[i].context.stats);
+	}
+}
+
+/*
+ * Take the next root move of the given worker, from its own queue or else from the queue of
+ * another worker. Returns false once all moves have been taken.
+ */
+int next_root_move(SplitWorker *worker, int *item) {
+	RootSplit *split = worker->split;
+	WorkQueue *queue = &worker->queue;
+	pthread_mutex_lock(&queue->lock);
+	int found = queue->head < queue->tail;
+	if (found) *item = queue->items[queue->head++];
+	pthread_mutex_unlock(&queue->lock);
+
+	for (int i = 0; !found && i < split->worker_count; i++) {
+		WorkQueue *victim = &split->workers[i].queue;
+		pthread_mutex_lock(&victim->lock);
+		found = victim->head < victim->tail;
+		if (found) *item = victim->items[--victim->tail];
+		pthread_mutex_unlock(&victim->lock);
+	}
+	return found;
+}
+
+/*
+ * Search a single root move. The window ends one point short of the best score found so far,
+ * so that a move scoring equal to the final best one is always scored exactly.
+ */
+void search_root_move(SplitWorker *worker, int item) {
+	RootSplit *split = worker->split;
+	Game *game = worker->game;
+	int best = __atomic_load_n(&split->best_score, __ATOMIC_RELAXED);
+	int son_score;
+
+	MoveUndo undo;
+	make_move(game, split->moves[item], &undo);
+	if (split->color == WHITE) {
+		int alpha = (best != INT_MIN) ? best - 1 : best;
+		worker->msg = minimax_node(game, &worker->context, worker->context.depth-1, alpha, INT_MAX, &son_score);
+		split->exact[item] = alpha == INT_MIN || son_score > alpha;
+	} else {
+		int beta = (best != INT_MAX) ? best + 1 : best;
+		worker->msg = minimax_node(game, &worker->context, worker->context.depth-1, INT_MIN, beta, &son_score);
+		split->exact[item] = beta == INT_MAX || son_score < beta;
+	}
+	unmake_move(game, &undo);
+	if (worker->msg != SUCCESS || worker->context.stopped || !split->exact[item]) return;
+	split->move_scores[item] = son_score;
+
+	/* Tighten the bound of later subtrees of all workers */
+	while ((split->color == WHITE) ? son_score > best : son_score < best) {
+		if (__atomic_compare_exchange_n(&split->best_score, &best, son_score, 0,
+				__ATOMIC_RELAXED, __ATOMIC_RELAXED)) break;
+	}
+}
+
+void *split_worker_run(void *arg) {
+	SplitWorker *worker = arg;
+	int item;
+	while (worker->msg == SUCCESS && !worker->context.stopped && next_root_move(worker, &item)) {
+		search_root_move(worker, item);
+	}
+	return NULL;
+}
+
+/*
+ * Search a single iteration by splitting the root moves between the given workers, the first
+ * of which runs on the calling thread. Suggests the same move as minimax_root.
+ */
+EngineMessage root_split_iteration(RootSplit *split, int max_depth, Move *suggested_move) {
+	SplitWorker *main_worker = &split->workers[0];
+	Game *game = main_worker->game;
+	SearchContext *context = &main_worker->context;
+	split->color = game->player_color[game->current_player];
+	context->stats.nodes++;
+
+	split->count = get_all_possible_moves(game, split->moves);
+	if (split->count == 0) return SUCCESS; /* game is over, there is no move to suggest */
+
+	/* Order all moves up front, the best ones are searched first by every worker */
+	int scores[MAX_MOVES];
+	for (int i = 0; i < split->count; i++) split->indices[i] = i;
+	TTEntry entry;
+	int found = tt_probe(game->tt, game->hash, &entry);
+	context->stats.tt_probes++;
+	if (found) context->stats.tt_hits++;
+	score_moves(game, split->moves, split->count, found ? entry.best_move : MOVE_NONE, &context->ordering, 0, scores);
+	for (int i = 0; i < split->count; i++) {
+		pick_next_move(split->moves, scores, split->indices, split->count, i);
+		split->exact[i] = 0;
+	}
+	split->best_score = (split->color == WHITE) ? INT_MIN : INT_MAX;
+
+	/* Search the first move alone to get a bound, then deal the others out in turn */
+	for (int i = 0; i < split->worker_count; i++) {
+		split->workers[i].context.depth = max_depth;
+		split->workers[i].msg = SUCCESS;
+		split->workers[i].queue.head = 0;
+		split->workers[i].queue.tail = 0;
+	}
+	search_root_move(main_worker, 0);
+	for (int i = 1; i < split->count; i++) {
+		WorkQueue *queue = &split->workers[i % split->worker_count].queue;
+		queue->items[queue->tail++] = i;
+	}
+
+	int started = 1;
+	while (started < split->worker_count
+			&& !pthread_create(&split->workers[started].thread, NULL, split_worker_run, &split->workers[started])) {
+		started++;
+	}
+	split_worker_run(main_worker);
+	for (int i = 1; i < started; i++) pthread_join(split->workers[i].thread, NULL);
+
+	for (int i = 0; i < started; i++) {
+		if (split->workers[i].msg != SUCCESS) return split->workers[i].msg;
+		if (split->workers[i].context.stopped) context->stopped = 1;
+	}
+	if (context->stopped) return SUCCESS;
 
-	if (node_score) *node_score = (current_player_color == WHITE) ? alpha : beta;
+	/* Suggest the best move, and the first generated one among equally good moves */
+	int best = -1;
+	for (int i = 0; i < split->count; i++) {
+		if (!split->exact[i]) continue;
+		if (best < 0) {
+			best = i;
+			continue;
+		}
+		int score = split->move_scores[i], best_score = split->move_scores[best];
+		int better = (split->color == WHITE) ? score > best_score : score < best_score;
+		if (better || (score == best_score && split->indices[i] < split->indices[best])) best = i;
+	}
+	*suggested_move = split->moves[best];
+	tt_store(game->tt, game->hash, max_depth, BOUND_EXACT, split->move_scores[best], *suggested_move);
 	return SUCCESS;
 }
 
-EngineMessage minimax_suggest_move(Game* game, unsigned int max_depth, GameMove *suggested_move) {
-	return minimax_node(game, max_depth, INT_MIN, INT_MAX, suggested_move, NULL);
+/*
+ * Search all iterations by splitting root moves between threads, each searching its own copy
+ * of the game allocated from the arena of the game. Fewer threads are used if a copy can't be
+ * created.
+ */
+EngineMessage root_split_search(Game *game, SearchContext *context, GameMove *suggested_move) {
+	SearchOptions *options = context->options;
+	int count = (options->threads > MAX_SEARCH_THREADS) ? MAX_SEARCH_THREADS : options->threads;
+	SplitWorker *workers = arena_alloc(context->arena, count * sizeof(SplitWorker));
+	if (!workers) return MALLOC_FAILURE;
+	RootSplit split;
+	int abort_search = 0;
+	for (int i = 0; i < count; i++) {
+		SplitWorker *worker = &workers[i];
+		if (i == 0) {
+			worker->game = game;
+		} else if ((worker->game = arena_alloc(context->arena, sizeof(Game)))) {
+			*worker->game = *game;
+		} else {
+			count = i;
+			break;
+		}
+		/* Workers search about equally many nodes, so the node limit is split evenly */
+		worker->options = *options;
+		if (options->node_limit) worker->options.node_limit = options->node_limit / count + 1;
+		init_search_context(&worker->context, &worker->options, &abort_search);
+		worker->context.deadline_us = context->deadline_us;
+		pthread_mutex_init(&worker->queue.lock, NULL);
+		worker->split = &split;
+	}
+	split.workers = workers;
+	split.worker_count = count;
+
+	EngineMessage msg = SUCCESS;
+	for (int depth = 1; depth <= (int)options->max_depth; depth++) {
+		Move move = MOVE_NONE;
+		msg = root_split_iteration(&split, depth, &move);
+		if (msg != SUCCESS || workers[0].context.stopped) break;
+		if (move != MOVE_NONE) unpack_move(move, suggested_move);
+		context->stats.completed_depth = depth;
+	}
+
+	for (int i = 0; i < count; i++) {
+		add_search_stats(&context->stats, &workers[i].context.stats);
+		pthread_mutex_destroy(&workers[i].queue.lock);
+	}
+	return msg;
+}
+
+EngineMessage minimax_suggest_move(Game* game, SearchOptions *options, GameMove *suggested_move, SearchStats *stats) {
+	/* Keep table with the game, so results are reused by the searches of later moves */
+	if (!game->tt && !(game->tt = create_transposition_table(hash_size_mb))) return MALLOC_FAILURE;
+	tt_new_search(game->tt);
+	/* Keep memory of threads with the game as well, so only the first threaded search of a game
+	 * allocates it. A single thread needs none */
+	if (options->threads > 1) {
+		if (!game->arena) {
+			if (!(game->arena = malloc(sizeof(Arena)))) return MALLOC_FAILURE;
+			arena_init(game->arena, 0);
+		}
+		arena_reset(game->arena);
+	}
+
+	long long start_us = current_time_us();
+	SearchContext context;
+	init_search_context(&context, options, NULL);
+	context.deadline_us = start_us + options->time_limit_ms * 1000LL;
+	context.arena = game->arena;
+
+	EngineMessage msg = SUCCESS;
+	if (options->threads > 1 && options->root_split) {
+		msg = root_split_search(game, &context, suggested_move);
+		context.stats.elapsed_ms = (current_time_us() - start_us) / 1000;
+		if (stats) *stats = context.stats;
+		return msg;
+	}
+
+	/* Helpers only fill the shared table. Exact scores and bounds don't depend on which thread
+	 * stored them, so the main thread suggests the same move it would alone, just sooner */
+	SearchHelper *helpers = NULL;
+	int abort_search = 0;
+	int helper_count = 0;
+	if (options->threads > 1) {
+		int requested = (options->threads > MAX_SEARCH_THREADS) ? MAX_SEARCH_THREADS : options->threads;
+		if ((helpers = arena_alloc(game->arena, (requested - 1) * sizeof(SearchHelper)))) {
+			helper_count = start_helpers(game, options, helpers, requested - 1, &abort_search, game->arena);
+		}
+	}
+
+	/* Deepen the search one ply at a time, and keep the move of the last completed iteration.
+	 * Ties are broken by generation order whatever order moves are searched in, so the final
+	 * iteration suggests the same move a single search to its depth would */
+	int score = 0;
+	for (context.depth = 1; context.depth <= (int)options->max_depth; context.depth++) {
+		Move move = MOVE_NONE;
+		msg = search_iteration(game, &context, score, &move, &score);
+		if (msg != SUCCESS || context.stopped) break;
+		if (move != MOVE_NONE) unpack_move(move, suggested_move);
+		context.stats.completed_depth = context.depth;
+	}
+	stop_helpers(helpers, helper_count, &abort_search, &context.stats);
+	context.stats.elapsed_ms = (current_time_us() - start_us) / 1000;
+	if (stats) *stats = context.stats;
+	return msg;
+}
+
+void init_search_options(SearchOptions *options, unsigned int max_depth) {
+	*options = default_options;
+	options->max_depth = max_depth;
+}
+
+void set_default_search_options(SearchOptions *options) {
+	default_options = *options;
 }
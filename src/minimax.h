@@ -2,17 +2,86 @@
 #define MINIMAX_H
 #include "game_engine.h"
 
+#define MAX_SEARCH_THREADS 64
+
+/* Struct defining the limits of a single search */
+typedef struct {
+	unsigned int max_depth; /* depth of the last iteration */
+	long time_limit_ms; /* wall-clock time budget in milliseconds, 0 for no limit */
+	long node_limit; /* maximum number of nodes to visit, 0 for no limit */
+	int quiescence; /* true to resolve captures at the leaves instead of scoring them statically */
+	int threads; /* number of threads searching in parallel, at most MAX_SEARCH_THREADS */
+	int root_split; /* true to split root moves between threads instead of sharing the table only */
+	int pvs; /* true to search moves after the first with a null window, and again only if better */
+	int aspiration_window; /* distance of root window ends from previous iteration's score, 0 for a full window */
+} SearchOptions;
+
+/* Struct counting what a single search did */
+typedef struct {
+	long nodes; /* nodes visited by the main search */
+	long qnodes; /* nodes visited by quiescence search */
+	long cutoffs; /* nodes whose remaining moves were skipped after a cutoff */
+	long first_move_cutoffs; /* cutoffs caused by the first move searched */
+	long tt_probes; /* transposition table lookups */
+	long tt_hits; /* lookups that found an entry of the same position */
+	int max_depth; /* deepest ply visited, including quiescence search */
+	int completed_depth; /* depth of the last completed iteration */
+	long long elapsed_ms; /* wall-clock time of the search in milliseconds */
+} SearchStats;
+
 /**
  * Given a game state, this function evaluates the best move according to
- * the current player. The function initiates a MiniMax alpha-betha pruning algorithm up to a
- * specified depth given by max_depth. The current game state doesn't change
- * by this function including the history of previous moves.
+ * the current player. The function initiates a MiniMax alpha-betha pruning algorithm
+ * deepened one ply at a time up to options->max_depth. If a time or node limit is reached,
+ * the move found by the last completed iteration is suggested (the first iteration is always
+ * completed). The current game state doesn't change by this function including the history
+ * of previous moves. With more than one thread, helper threads search copies of the game
+ * ahead of the main search and share results through the transposition table, or with
+ * root_split set, threads divide the moves of each iteration and share the best score found.
+ * Either way the suggested move is the one a single thread completing the same iterations
+ * would suggest. Principal variation search and aspiration windows (not used by root_split)
+ * only change how many nodes are visited, not the suggested move.
  *
  * @param game - The current game state
- * @param max_depth - The maximum depth of the algorithm
+ * @param options - The depth and limits of the search
  * @param suggestem_move - On success, will be filled with the suggested move calculated by the algorithm.
+ * @param stats - If not NULL, will be filled with the statistics of the search. Counters include
+ * the nodes of an iteration stopped by a limit.
+ */
+EngineMessage minimax_suggest_move(Game* game, SearchOptions *options, GameMove *suggested_move, SearchStats *stats);
+
+/**
+ * Initialize search options to the given depth and the defaults set by
+ * set_default_search_options.
+ *
+ * @param options - The options to be initialized
+ * @param max_depth - The maximum depth of the search
+ */
+void init_search_options(SearchOptions *options, unsigned int max_depth);
+
+/**
+ * Set the default options of searches, used by init_search_options. All limits and features
+ * are off unless set by this function.
+ *
+ * @param options - The default options, max_depth is ignored
+ */
+void set_default_search_options(SearchOptions *options);
+
+/**
+ * Set the memory budget of transposition tables. Each game allocates its table on its first
+ * search and keeps it for the searches of later moves, so the budget only applies to tables
+ * allocated after this call.
+ *
+ * @param megabytes - The memory budget of a single table in megabytes
+ */
+void set_hash_size(size_t megabytes);
+
+/**
+ * Get the memory budget of transposition tables set by set_hash_size.
+ *
+ * @return The memory budget of a single table in megabytes
  */
-EngineMessage minimax_suggest_move(Game* game, unsigned int max_depth, GameMove *suggested_move);
+size_t get_hash_size();
 
 #endif /* ifndef MINIMAX_H */
 
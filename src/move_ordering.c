@@ -0,0 +1,78 @@
+#include <string.h>
+#include "move_ordering.h"
+
+#define HASH_MOVE_SCORE 1000000
+#define CAPTURE_SCORE 500000
+#define KILLER_SCORE 400000
+/* History scores are halved once one of them reaches this value, so quiet moves always
+ * rank below killers */
+#define HISTORY_MAX 100000
+
+void clear_ordering_tables(OrderingTables *tables){
+	/* Killers are cleared to MOVE_NONE */
+	memset(tables, 0, sizeof(OrderingTables));
+}
+
+void score_moves(Game *game, Move *moves, int count, Move hash_move, OrderingTables *tables, int ply, int *scores){
+	Color color = game->player_color[game->current_player];
+	for(int i = 0; i < count; i++){
+		Move move = moves[i];
+		int src = MOVE_SRC(move), dst = MOVE_DST(move);
+		if(hash_move != MOVE_NONE && is_same_move(move, hash_move)){
+			scores[i] = HASH_MOVE_SCORE;
+		} else if(move & MOVE_CAPTURE){
+			GamePiece *victim = get_game_piece(game, SQUARE_X(dst), SQUARE_Y(dst));
+			GamePiece *attacker = get_game_piece(game, SQUARE_X(src), SQUARE_Y(src));
+			scores[i] = CAPTURE_SCORE + piece_values[victim->type] * 256 - piece_values[attacker->type];
+		} else if(ply < MAX_PLY && is_same_move(move, tables->killers[ply][0])){
+			scores[i] = KILLER_SCORE + 1;
+		} else if(ply < MAX_PLY && is_same_move(move, tables->killers[ply][1])){
+			scores[i] = KILLER_SCORE;
+		} else {
+			scores[i] = tables->history[color][src][dst];
+		}
+	}
+}
+
+void pick_next_move(Move *moves, int *scores, int *indices, int count, int index){
+	int best = index;
+	for(int i = index + 1; i < count; i++){
+		if(scores[i] > scores[best]) best = i;
+	}
+	if(best == index) return;
+
+	Move move = moves[index];
+	moves[index] = moves[best];
+	moves[best] = move;
+	int score = scores[index];
+	scores[index] = scores[best];
+	scores[best] = score;
+	if(indices){
+		int temp = indices[index];
+		indices[index] = indices[best];
+		indices[best] = temp;
+	}
+}
+
+void update_ordering_tables(OrderingTables *tables, Color color, Move move, int ply, int depth){
+	if(ply < MAX_PLY && !is_same_move(move, tables->killers[ply][0])){
+		tables->killers[ply][1] = tables->killers[ply][0];
+		tables->killers[ply][0] = move;
+	}
+
+	int *entry = &tables->history[color][MOVE_SRC(move)][MOVE_DST(move)];
+	*entry += depth * depth;
+	if(*entry >= HISTORY_MAX){
+		/* Age all entries of this color, keeping their relative order */
+		for(int src = 0; src < SQUARE_COUNT; src++){
+			for(int dst = 0; dst < SQUARE_COUNT; dst++){
+				tables->history[color][src][dst] /= 2;
+			}
+		}
+	}
+}
+
+int is_same_move(Move a, Move b){
+	/* Flags of the same move may differ between positions, e.g. killers of sibling positions */
+	return ((a ^ b) & MOVE_SQUARES_MASK) == 0;
+}
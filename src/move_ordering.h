@@ -0,0 +1,74 @@
+#ifndef MOVE_ORDERING_H
+#define MOVE_ORDERING_H
+/*
+ * Move ordering module, ranking generated moves so that the moves most likely to cause an
+ * alpha-beta cutoff are searched first. Moves are ranked in the following order:
+ * 1. hash move, i.e. best move stored for the position by an earlier search
+ * 2. captures, most valuable victim first and least valuable attacker among equal victims
+ * 3. killer moves, quiet moves that caused a cutoff in a sibling position at the same ply
+ * 4. other quiet moves, by history of cutoffs they caused anywhere in the search
+ *
+ * Summary of interface:
+ * clear_ordering_tables  	 reset killers and history
+ * score_moves            	 rank generated moves
+ * pick_next_move         	 move highest ranked remaining move to the given index
+ * update_ordering_tables 	 record a quiet move that caused a cutoff
+ * is_same_move           	 compare two moves
+ */
+#include "game_engine.h"
+
+#define MAX_PLY 64
+#define KILLER_COUNT 2
+
+/* Struct holding the tables learned from cutoffs during a search */
+typedef struct {
+	Move killers[MAX_PLY][KILLER_COUNT]; /* quiet cutoff moves per ply, newest first */
+	int history[COLOR_COUNT][SQUARE_COUNT][SQUARE_COUNT]; /* cutoff weight per color, source and target */
+} OrderingTables;
+
+/*
+ * Reset all killers and history of given tables.
+ * @param tables 	 tables to be cleared
+ */
+void clear_ordering_tables(OrderingTables *tables);
+
+/*
+ * Rank generated moves of the current player, higher scores are searched first.
+ * @param game      	 game instance
+ * @param moves     	 generated moves
+ * @param count     	 number of moves
+ * @param hash_move 	 best move stored for the position, MOVE_NONE if none
+ * @param tables    	 killers and history of the search
+ * @param ply       	 distance of the position from the root of the search
+ * @param scores    	 buffer to be filled with the score of each move
+ */
+void score_moves(Game *game, Move *moves, int count, Move hash_move, OrderingTables *tables, int ply, int *scores);
+
+/*
+ * Move the highest ranked move among moves[index..count-1] to the given index, using a
+ * single step of selection sort so that moves after a cutoff are never sorted.
+ * @param moves   	 generated moves
+ * @param scores  	 scores of the moves
+ * @param indices 	 generation order index of each move to be kept in sync, may be NULL
+ * @param count   	 number of moves
+ * @param index   	 index to be filled
+ */
+void pick_next_move(Move *moves, int *scores, int *indices, int count, int index);
+
+/*
+ * Record a quiet move that caused a cutoff, as a killer move and in history.
+ * @param tables 	 killers and history of the search
+ * @param color  	 color of the moving player
+ * @param move   	 move that caused the cutoff
+ * @param ply    	 distance of the position from the root of the search
+ * @param depth  	 remaining depth of the position
+ */
+void update_ordering_tables(OrderingTables *tables, Color color, Move move, int ply, int depth);
+
+/*
+ * Check whether two moves are the same.
+ * @return 	 true iff both moves have the same source and target positions
+ */
+int is_same_move(Move a, Move b);
+
+#endif /* ifndef MOVE_ORDERING_H */
@@ -0,0 +1,69 @@
+#include <stdlib.h>
+
+#include "perft.h"
+#include "print_utils.h"
+#include "timer.h"
+
+/*
+ * Order moves by source and then target position, row first.
+ */
+static int compare_moves(const void *a, const void *b){
+	Move m1 = *(const Move *)a, m2 = *(const Move *)b;
+	if(MOVE_SRC(m1) != MOVE_SRC(m2)) return MOVE_SRC(m1) - MOVE_SRC(m2);
+	return MOVE_DST(m1) - MOVE_DST(m2);
+}
+
+long perft(Game *game, int depth){
+	if(depth == 0) return 1;
+
+	Move moves[MAX_MOVES];
+	int count = get_all_possible_moves(game, moves);
+	/* Moves are legal, so the last ply needs no make and unmake */
+	if(depth == 1) return count;
+
+	long nodes = 0;
+	for(int i = 0; i < count; i++){
+		MoveUndo undo;
+		make_move(game, moves[i], &undo);
+		nodes += perft(game, depth-1);
+		unmake_move(game, &undo);
+	}
+	return nodes;
+}
+
+EngineMessage run_perft(const char *file, int depth){
+	FILE *in = fopen(file, "r");
+	if(!in) return LOAD_ERROR;
+	Game *game = load_game(in);
+	fclose(in);
+	if(!game) return LOAD_ERROR;
+
+	long long start_us = current_time_us();
+
+	/* Divide: print the count of each root move, so that a wrong total can be traced down */
+	Move moves[MAX_MOVES];
+	int count = get_all_possible_moves(game, moves);
+	qsort(moves, count, sizeof(Move), compare_moves);
+	long nodes = 0;
+	for(int i = 0; i < count; i++){
+		MoveUndo undo;
+		make_move(game, moves[i], &undo);
+		long move_nodes = perft(game, depth-1);
+		unmake_move(game, &undo);
+		nodes += move_nodes;
+		GameMove move;
+		unpack_move(moves[i], &move);
+		print_position_repr(move.src_x, move.src_y);
+		printf(" -> ");
+		print_position_repr(move.dst_x, move.dst_y);
+		printf(": %ld\n", move_nodes);
+	}
+
+	double seconds = (current_time_us() - start_us) / 1e6;
+	printf("\nMoves: %d\n", count);
+	printf("Nodes: %ld\n", nodes);
+	printf("Time: %.0f ms\n", seconds * 1000);
+	printf("NPS: %.0f\n", seconds > 0 ? nodes / seconds : 0.0);
+	destroy_game(game);
+	return SUCCESS;
+}
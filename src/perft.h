@@ -0,0 +1,31 @@
+#ifndef PERFT_H
+#define PERFT_H
+/*
+ * Perft module counting the leaf nodes of the legal move tree of a position, used to
+ * verify the move generator against known counts and to measure its speed.
+ *
+ * Summary of interface:
+ * perft     	 count leaf nodes of the move tree of a game to a given depth
+ * run_perft 	 load a position from file, print node count of each root move and speed
+ */
+#include "game_engine.h"
+
+/*
+ * Count the positions reachable from the given game in exactly depth plies.
+ * The game is restored to its original state on return.
+ * @param game  	 game instance to count positions of
+ * @param depth 	 number of plies to search
+ * @return      	 number of leaf nodes
+ */
+long perft(Game *game, int depth);
+
+/*
+ * Load a game from file and print the number of leaf nodes below each of its moves
+ * (divide), followed by the total node count, time taken and nodes per second.
+ * @param file  	 path of a saved game
+ * @param depth 	 number of plies to search, at least 1
+ * @return      	 SUCCESS on success, LOAD_ERROR if the file could not be loaded
+ */
+EngineMessage run_perft(const char *file, int depth);
+
+#endif /* ifndef PERFT_H */
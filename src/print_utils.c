@@ -16,7 +16,7 @@ void print_game_error(Game *game, EngineMessage msg, GameCommand *cmd){
 				char *str;
 				int *arg = (int *)cmd->arg;
 				/* Get game piece at source position */
-				GamePiece *piece = game->board[arg[1]][arg[0]];
+				GamePiece *piece = get_game_piece(game, arg[0], arg[1]);
 				if(!piece || piece->color != game->player_color[game->current_player]){
 					str = "The specified position does not contain your piece\n";
 				} else {
@@ -57,6 +57,16 @@ void print_computer_move(PieceType type, GameMove *move){
 	putchar('\n');
 }
 
+void print_search_stats(SearchStats *stats){
+	long nodes = stats->nodes + stats->qnodes;
+	fprintf(stderr, "Search: depth %d, max depth %d, nodes %ld (quiescence %ld), time %lld ms, NPS %lld\n",
+			stats->completed_depth, stats->max_depth, nodes, stats->qnodes, stats->elapsed_ms,
+			stats->elapsed_ms > 0 ? nodes * 1000LL / stats->elapsed_ms : 0);
+	fprintf(stderr, "Search: cutoffs %ld, first move cutoffs %.1f%%, TT probes %ld, TT hits %.1f%%\n",
+			stats->cutoffs, stats->cutoffs ? 100.0 * stats->first_move_cutoffs / stats->cutoffs : 0.0,
+			stats->tt_probes, stats->tt_probes ? 100.0 * stats->tt_hits / stats->tt_probes : 0.0);
+}
+
 char *get_type_repr(PieceType type){
 	switch (type) {
 		case PAWN:
@@ -117,21 +127,19 @@ void print_generic_message(EngineMessage msg){
 	}
 }
 
-void print_undo_two_moves(Game *game, GameMove *moves[]){
-	GameMove *move = moves[0];
+void print_undo_two_moves(Game *game, GameMove moves[]){
+	GameMove *move = &moves[0];
 	Color color = !game->player_color[game->current_player];
 	printf("Undo move for player %s : <%d,%c> -> <%d,%c>\n",
 			(color == WHITE) ? "white" : "black",
 			move->dst_y+1, move->dst_x+'A',
 			move->src_y+1, move->src_x+'A');
-	move = moves[1];
+	move = &moves[1];
 	color = !color;
 	printf("Undo move for player %s : <%d,%c> -> <%d,%c>\n",
 			(color == WHITE) ? "white" : "black",
 			move->dst_y+1, move->dst_x+'A',
 			move->src_y+1, move->src_x+'A');
-	free(moves[0]);
-	free(moves[1]);
 }
 
 void print_check(Color color, Mode mode, Player current_player){
@@ -165,7 +173,7 @@ void print_board(Game *game){
 		/* Print row */
 		printf("%d|", i+1);
 		for (int j = 0; j < BOARD_SIZE; ++j) {
-			printf(" %c", get_piece_repr(game->board[i][j]));
+			printf(" %c", get_piece_repr(get_game_piece(game, j, i)));
 		}
 		printf(" |\n");
 	}
@@ -216,53 +224,33 @@ void print_settings(GameSettings *settings){
 	}
 }
 
-int print_possible_moves(Game *game, SPArrayList *moves){
-	/* Create new list and use insertion sort */
-	int count = spArrayListSize(moves);
-	SPArrayList *list = spArrayListCreate(sizeof(GameMove), count);
-	if(!list) return 0;
-	/* Use insertion sort */
-	spArrayListAddFirst(list, spArrayListGetFirst(moves));
-	for (int i = 1; i < count; ++i) {
-		GameMove *move = spArrayListGetAt(moves, i);
-		int j = 0;
-		GameMove *temp = (GameMove *)spArrayListGetAt(list, j);
-		while(j < count-1 && temp
-				&& compare_positions(move->dst_x, move->dst_y, temp->dst_x, temp->dst_y)>0){
-			j++;
-			temp = (GameMove *)spArrayListGetAt(list, j);
-		}
-		spArrayListAddAt(list, copy_move(move), j);
-	}
-
-	/* Create list of string representations of move destinations */
-	SPArrayList *strings = spArrayListCreate(POS_REPR_MAX_LENGTH + 1, count);
-	if(!strings){
-		spArrayListDestroy(list);
-		return 0;
-	}
+int print_possible_moves(Game *game, GameMove *moves, int count){
+	/* Sort a local copy of the moves by destination using insertion sort */
+	GameMove sorted[MAX_PIECE_MOVES];
 	for (int i = 0; i < count; ++i) {
-		char *repr = get_destination_repr(game, spArrayListGetAt(list, i));
-		if(!repr){
-			spArrayListDestroy(list);
-			spArrayListDestroy(strings);
-			return 0;
+		int j = i;
+		while(j > 0 && compare_positions(moves[i].dst_x, moves[i].dst_y,
+					sorted[j-1].dst_x, sorted[j-1].dst_y) < 0){
+			sorted[j] = sorted[j-1];
+			j--;
 		}
-		spArrayListAddAt(strings, repr, i);
+		sorted[j] = moves[i];
 	}
-	/* Print generated representations */
+
+	/* Print string representations of move destinations */
 	for (int i = 0; i < count; ++i) {
-		printf("%s\n", (char *)spArrayListGetAt(strings, i));
+		char *repr = get_destination_repr(game, &sorted[i]);
+		if(!repr) return 0;
+		printf("%s\n", repr);
+		free(repr);
 	}
-	spArrayListDestroy(list);
-	spArrayListDestroy(strings);
 	return 1;
 }
 
 char *get_destination_repr(Game *game, GameMove *move){
-	GamePiece *dst_piece = game->board[move->dst_y][move->dst_x];
+	GamePiece *dst_piece = get_game_piece(game, move->dst_x, move->dst_y);
 	int capture = dst_piece && (dst_piece->color == game->player_color[!game->current_player]);
-	GamePiece *src_piece = game->board[move->src_y][move->src_x];
+	GamePiece *src_piece = get_game_piece(game, move->src_x, move->src_y);
 	int dst_threat = is_piece_threatened_after_move(game, src_piece, move);
 	int row = move->dst_y+1;
 	char col = move->dst_x+'A';
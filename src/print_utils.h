@@ -7,6 +7,7 @@
 
 #include "game_engine.h"
 #include "command_parser.h"
+#include "minimax.h"
 
 #define GAME_PROMPT "player - enter your move:\n"
 #define SETTINGS_PROMPT "Specify game setting or type 'start' to begin a game with the current setting:\n"
@@ -34,6 +35,12 @@ void print_game_error(Game *game, EngineMessage msg, GameCommand *cmd);
  */
 void print_computer_move(PieceType type, GameMove *move);
 
+/*
+ * Print statistics of a search to stderr, so that they don't mix with game output.
+ * @param stats 	 statistics of the search
+ */
+void print_search_stats(SearchStats *stats);
+
 /*
  * Convert piece type into a representing string.
  * @param type 	 type of game piece to represent
@@ -65,7 +72,7 @@ void print_settings_error(SettingCommand *cmd);
  * @param game  	 game instance
  * @param moves 	 moves that were undone
  */
-void print_undo_two_moves(Game *game, GameMove *moves[]);
+void print_undo_two_moves(Game *game, GameMove moves[]);
 
 /*
  * Print message informing user his king is threatened.
@@ -101,13 +108,14 @@ void print_board(Game *game);
 void print_settings(GameSettings *settings);
 
 /*
- * Print moves from given list in sorted order, and add special characters
+ * Print moves from given buffer in sorted order, and add special characters
  * as defined in project requirements.
  * @param game  	 game instance
- * @param moves 	 list of possible moves to print
+ * @param moves 	 buffer of possible moves to print, at most MAX_PIECE_MOVES
+ * @param count 	 number of moves in buffer
  * @return      	 true on success, false on memory failure
  */
-int print_possible_moves(Game *game, SPArrayList *moves);
+int print_possible_moves(Game *game, GameMove *moves, int count);
 
 /*******************************************************************************************/
 /**************** Auxiliary functions - should not be called outside this module ***********/
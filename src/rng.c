@@ -0,0 +1,30 @@
+#include "rng.h"
+
+/* Distance between the two taps of the generator */
+#define RNG_SEPARATION 3
+/* Numbers discarded after seeding, so that the sequence no longer depends on the seed linearly */
+#define RNG_WARMUP (RNG_DEGREE * 10)
+
+void rng_seed(RngState *rng, unsigned int seed){
+	/* Fill the table from the seed with a Park-Miller generator, using Schrage's method to
+	 * compute 16807 * x % (2^31 - 1) without overflow */
+	int64_t word = seed ? seed : 1;
+	rng->table[0] = word;
+	for(int i = 1; i < RNG_DEGREE; i++){
+		int64_t hi = word / 127773;
+		int64_t lo = word % 127773;
+		word = 16807 * lo - 2836 * hi;
+		if(word < 0) word += 2147483647;
+		rng->table[i] = word;
+	}
+	rng->front = RNG_SEPARATION;
+	rng->rear = 0;
+	for(int i = 0; i < RNG_WARMUP; i++) rng_next(rng);
+}
+
+int rng_next(RngState *rng){
+	uint32_t value = rng->table[rng->front] += rng->table[rng->rear];
+	if(++rng->front == RNG_DEGREE) rng->front = 0;
+	if(++rng->rear == RNG_DEGREE) rng->rear = 0;
+	return value >> 1;
+}
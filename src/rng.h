@@ -0,0 +1,40 @@
+#ifndef RNG_H
+#define RNG_H
+/*
+ * Random number generator module with explicit state, so that a sequence can be reproduced
+ * from its seed regardless of other users of the C library generator.
+ * The generator is the additive feedback generator of glibc's rand(), so a state seeded with
+ * DEFAULT_RNG_SEED produces the same sequence as rand() before any call to srand().
+ *
+ * Summary of interface:
+ * rng_seed 	 reset a generator state to the start of the sequence of a seed
+ * rng_next 	 get next number of a generator state
+ */
+#include <stdint.h>
+
+#define RNG_MAX 2147483647
+#define RNG_DEGREE 31
+#define DEFAULT_RNG_SEED 1
+
+/* Struct holding the state of a single generator */
+typedef struct {
+	uint32_t table[RNG_DEGREE];
+	int front; /* index of the next number to be updated */
+	int rear; /* index of the number added to it */
+} RngState;
+
+/*
+ * Reset the given generator state to the start of the sequence of the given seed.
+ * @param rng  	 generator state
+ * @param seed 	 seed of the sequence, 0 is treated as 1
+ */
+void rng_seed(RngState *rng, unsigned int seed);
+
+/*
+ * Advance the given generator state and get its next number.
+ * @param rng 	 generator state
+ * @return    	 a number between 0 and RNG_MAX
+ */
+int rng_next(RngState *rng);
+
+#endif /* ifndef RNG_H */
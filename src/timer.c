@@ -0,0 +1,9 @@
+#define _POSIX_C_SOURCE 200809L /* for clock_gettime */
+#include <time.h>
+#include "timer.h"
+
+long long current_time_us(){
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (long long)now.tv_sec * 1000000 + now.tv_nsec / 1000;
+}
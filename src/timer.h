@@ -0,0 +1,18 @@
+#ifndef TIMER_H
+#define TIMER_H
+/*
+ * Timer module reading a monotonic clock, used to limit searches and to time perft and bench
+ * runs.
+ *
+ * Summary of interface:
+ * current_time_us 	 get the time of the monotonic clock in microseconds
+ */
+
+/*
+ * Get the time of a monotonic clock, which isn't affected by changes to the system time. Only
+ * the difference between two calls is meaningful.
+ * @return 	 current time in microseconds
+ */
+long long current_time_us();
+
+#endif /* ifndef TIMER_H */
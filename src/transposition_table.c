@@ -0,0 +1,87 @@
+#include <stdlib.h>
+#include <string.h>
+#include "transposition_table.h"
+
+/* Layout of the packed data word of a slot */
+#define MOVE_SHIFT 32
+#define DEPTH_SHIFT 48
+#define BOUND_SHIFT 56
+#define GENERATION_SHIFT 58
+#define MOVE_MASK 0xffff
+#define DEPTH_MASK 0xff
+#define BOUND_MASK 0x3
+#define GENERATION_MASK 0x3f /* generations are compared modulo 64 */
+
+static uint64_t pack_entry(int depth, BoundType bound, int score, Move best_move, unsigned char generation){
+	uint64_t data = (uint32_t)score;
+	data |= (uint64_t)best_move << MOVE_SHIFT;
+	data |= (uint64_t)(depth & DEPTH_MASK) << DEPTH_SHIFT;
+	data |= (uint64_t)bound << BOUND_SHIFT;
+	data |= (uint64_t)(generation & GENERATION_MASK) << GENERATION_SHIFT;
+	return data;
+}
+
+static void unpack_entry(uint64_t data, TTEntry *entry){
+	entry->score = (int32_t)(uint32_t)data;
+	entry->best_move = (data >> MOVE_SHIFT) & MOVE_MASK;
+	entry->depth = (data >> DEPTH_SHIFT) & DEPTH_MASK;
+	entry->bound = (data >> BOUND_SHIFT) & BOUND_MASK;
+	entry->generation = (data >> GENERATION_SHIFT) & GENERATION_MASK;
+}
+
+TranspositionTable *create_transposition_table(size_t megabytes){
+	TranspositionTable *table = malloc(sizeof(TranspositionTable));
+	if(!table) return NULL;
+
+	/* Use the largest power of two number of entries that fits in the budget */
+	size_t count = 1;
+	while(count * 2 * sizeof(TTSlot) <= megabytes * 1024 * 1024) count *= 2;
+	table->slots = calloc(count, sizeof(TTSlot));
+	if(!table->slots){
+		free(table);
+		return NULL;
+	}
+	table->mask = count - 1;
+	table->generation = 0;
+	return table;
+}
+
+void destroy_transposition_table(TranspositionTable *table){
+	if(!table) return;
+	free(table->slots);
+	free(table);
+}
+
+void clear_transposition_table(TranspositionTable *table){
+	memset(table->slots, 0, (table->mask + 1) * sizeof(TTSlot));
+	table->generation = 0;
+}
+
+void tt_new_search(TranspositionTable *table){
+	table->generation++;
+}
+
+int tt_probe(TranspositionTable *table, ZobristKey key, TTEntry *entry){
+	TTSlot *slot = &table->slots[key & table->mask];
+	uint64_t check = __atomic_load_n(&slot->check, __ATOMIC_RELAXED);
+	uint64_t data = __atomic_load_n(&slot->data, __ATOMIC_RELAXED);
+	/* Empty slots hold no bound, torn slots fail the key check */
+	if((check ^ data) != key) return 0;
+	unpack_entry(data, entry);
+	return entry->bound != BOUND_NONE;
+}
+
+void tt_store(TranspositionTable *table, ZobristKey key, int depth, BoundType bound, int score, Move best_move){
+	TTSlot *slot = &table->slots[key & table->mask];
+	uint64_t check = __atomic_load_n(&slot->check, __ATOMIC_RELAXED);
+	uint64_t data = __atomic_load_n(&slot->data, __ATOMIC_RELAXED);
+	/* Keep deeper results of the current search over shallower ones of other positions */
+	TTEntry old;
+	unpack_entry(data, &old);
+	if(old.bound != BOUND_NONE && (check ^ data) != key
+			&& old.generation == (table->generation & GENERATION_MASK) && old.depth > depth) return;
+
+	data = pack_entry(depth, bound, score, best_move, table->generation);
+	__atomic_store_n(&slot->check, key ^ data, __ATOMIC_RELAXED);
+	__atomic_store_n(&slot->data, data, __ATOMIC_RELAXED);
+}
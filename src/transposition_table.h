@@ -0,0 +1,101 @@
+#ifndef TRANSPOSITION_TABLE_H
+#define TRANSPOSITION_TABLE_H
+/*
+ * Transposition table module caching search results by position key.
+ * The table is a fixed-size array of entries whose length is a power of two, so an entry is
+ * found by masking the low bits of the key. Each slot holds a single entry, which is replaced
+ * by a new result unless it holds a deeper result of the current search.
+ * Threads may probe and store concurrently without locking: each slot is packed into two words
+ * and its key is stored xored with its data, so a slot torn by concurrent stores doesn't match
+ * the key of any position and is ignored by probes.
+ *
+ * Summary of interface:
+ * create_transposition_table  	 allocate a table within a given memory budget
+ * destroy_transposition_table 	 free all memory of a table
+ * clear_transposition_table   	 remove all entries from a table
+ * tt_new_search               	 mark entries of previous searches as replaceable
+ * tt_probe                    	 find entry of a given position
+ * tt_store                    	 store search result of a given position
+ */
+#include <stddef.h>
+#include <stdint.h>
+#include "zobrist.h"
+#include "game_engine.h"
+
+#define DEFAULT_HASH_SIZE_MB 16
+
+typedef enum {
+	BOUND_NONE,
+	BOUND_EXACT, /* score is the exact value of the position */
+	BOUND_LOWER, /* value of the position is at least score */
+	BOUND_UPPER  /* value of the position is at most score */
+} BoundType;
+
+/* Struct defining a single search result, as read from the table */
+typedef struct {
+	int score;
+	Move best_move; /* best move found, MOVE_NONE if none */
+	unsigned char depth;
+	unsigned char bound;
+	unsigned char generation; /* search in which the entry was stored */
+} TTEntry;
+
+/* Struct defining a single slot of the table */
+typedef struct {
+	uint64_t check; /* key of the position xored with data */
+	uint64_t data; /* packed entry */
+} TTSlot;
+
+typedef struct TranspositionTable {
+	TTSlot *slots;
+	size_t mask; /* number of entries minus one */
+	unsigned char generation; /* current search */
+} TranspositionTable;
+
+/*
+ * Create a new, empty transposition table.
+ * @param megabytes 	 memory budget of the table, at least one entry is allocated
+ * @return          	 pointer to the new table on success, NULL on memory failure
+ */
+TranspositionTable *create_transposition_table(size_t megabytes);
+
+/*
+ * Free all memory of given table.
+ * @param table 	 table to be destroyed, may be NULL
+ */
+void destroy_transposition_table(TranspositionTable *table);
+
+/*
+ * Remove all entries of given table.
+ * @param table 	 transposition table
+ */
+void clear_transposition_table(TranspositionTable *table);
+
+/*
+ * Start a new search. Entries stored by previous searches are kept, but may be replaced by
+ * shallower results.
+ * @param table 	 transposition table
+ */
+void tt_new_search(TranspositionTable *table);
+
+/*
+ * Find entry of given position.
+ * @param table 	 transposition table
+ * @param key   	 key of the position
+ * @param entry 	 variable to copy the entry of the position into
+ * @return      	 true iff the table holds an entry of the position
+ */
+int tt_probe(TranspositionTable *table, ZobristKey key, TTEntry *entry);
+
+/*
+ * Store search result of given position, according to the replacement policy.
+ * @param table     	 transposition table
+ * @param key       	 key of the position
+ * @param depth     	 depth the position was searched to
+ * @param bound     	 relation of the score to the value of the position
+ * @param score     	 score returned by the search
+ * @param best_move 	 best move found, MOVE_NONE if none
+ */
+void tt_store(TranspositionTable *table, ZobristKey key, int depth, BoundType bound, int score, Move best_move);
+
+#endif /* ifndef TRANSPOSITION_TABLE_H */
@@ -0,0 +1,39 @@
+#include "zobrist.h"
+
+#define ZOBRIST_SEED 0x2545F4914F6CDD1DULL
+
+static ZobristKey piece_keys[ZOBRIST_COLOR_COUNT][ZOBRIST_PIECE_TYPE_COUNT][SQUARE_COUNT];
+static ZobristKey side_key;
+static int initialized = 0;
+
+/*
+ * Get next value of a splitmix64 sequence with the given state.
+ */
+static ZobristKey next_key(uint64_t *state){
+	uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	return z ^ (z >> 31);
+}
+
+void init_zobrist_keys(){
+	if(initialized) return;
+	uint64_t state = ZOBRIST_SEED;
+	for(int color = 0; color < ZOBRIST_COLOR_COUNT; color++){
+		for(int type = 0; type < ZOBRIST_PIECE_TYPE_COUNT; type++){
+			for(int sq = 0; sq < SQUARE_COUNT; sq++){
+				piece_keys[color][type][sq] = next_key(&state);
+			}
+		}
+	}
+	side_key = next_key(&state);
+	initialized = 1;
+}
+
+ZobristKey zobrist_piece_key(int color, int type, int sq){
+	return piece_keys[color][type][sq];
+}
+
+ZobristKey zobrist_side_key(){
+	return side_key;
+}
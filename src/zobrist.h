@@ -0,0 +1,42 @@
+#ifndef ZOBRIST_H
+#define ZOBRIST_H
+/*
+ * Zobrist hashing module containing the random keys used to identify board positions.
+ * The key of a position is the XOR of the keys of all pieces on their squares, and of the
+ * side key when black is to move, so it can be updated in O(1) per piece placement.
+ *
+ * Summary of interface:
+ * init_zobrist_keys 	 generate keys, must be called before any other function
+ * zobrist_piece_key 	 get key of a piece of given color and type on a given square
+ * zobrist_side_key  	 get key flipped whenever the color to move changes
+ */
+#include <stdint.h>
+#include "bitboard.h"
+
+#define ZOBRIST_COLOR_COUNT 2
+#define ZOBRIST_PIECE_TYPE_COUNT 6
+
+typedef uint64_t ZobristKey;
+
+/*
+ * Generate all keys from a fixed seed, so that keys are identical between runs.
+ * Calling this function more than once has no effect.
+ */
+void init_zobrist_keys();
+
+/*
+ * Get key of a single piece on a single square.
+ * @param color 	 color of the piece
+ * @param type  	 type of the piece
+ * @param sq    	 square of the piece
+ * @return      	 key of the piece on the square
+ */
+ZobristKey zobrist_piece_key(int color, int type, int sq);
+
+/*
+ * Get key representing the color to move.
+ * @return 	 side key
+ */
+ZobristKey zobrist_side_key();
+
+#endif /* ifndef ZOBRIST_H */